@@ -7,12 +7,14 @@ class InfluxdbCxxConan(ConanFile):
     options = {
         "tests": [True, False],
         "system": [True, False],
-        "boost": [True, False]
+        "boost": [True, False],
+        "arrow": [True, False]
     }
     default_options = {
         "tests": True,
         "system": False,
         "boost": True,
+        "arrow": False,
         "boost/*:shared": True,
     }
 
@@ -20,6 +22,8 @@ class InfluxdbCxxConan(ConanFile):
         self.requires("cpr/1.14.2")
         if not self.options.system and self.options.boost:
             self.requires("boost/1.88.0")
+        if self.options.arrow:
+            self.requires("arrow/19.0.1")
         if self.options.tests:
             self.requires("catch2/3.14.0")
             self.requires("trompeloeil/49")
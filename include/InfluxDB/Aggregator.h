@@ -0,0 +1,115 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INFLUXDATA_AGGREGATOR_H
+#define INFLUXDATA_AGGREGATOR_H
+
+#include "InfluxDB/Point.h"
+#include "InfluxDB/influxdb_export.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace influxdb
+{
+    /// Aggregation of a field over a window
+    enum class Aggregation
+    {
+        Sum,
+        Min,
+        Max,
+        Count,
+        Last,
+        Mean
+    };
+
+    /// Returns the name of the aggregation ("sum", "min", "max", "count", "last", "mean")
+    INFLUXDB_EXPORT std::string_view toString(Aggregation aggregation);
+
+    /// \brief Downsamples points per series over time windows
+    ///
+    /// Points of the same series (measurement and tag set) within a window,
+    /// aligned to the epoch, are aggregated into a single point timestamped
+    /// with the start of the window. Numeric fields are written as
+    /// "<field>_<aggregation>" (sum, min, max and mean as float, count as
+    /// integer, last as received); other fields keep their last value.
+    ///
+    /// A window is emitted once a point of a later window arrives, so memory is
+    /// bounded by the number of active series. Points of completed windows,
+    /// which are older than the latest window of any series, are passed
+    /// through unaggregated. Not thread-safe.
+    class INFLUXDB_EXPORT Aggregator
+    {
+    public:
+        /// Constructor
+        /// \param window        length of the windows
+        /// \param aggregations  applied to each numeric field
+        /// \throw InfluxDBException	if window or aggregations are empty
+        Aggregator(std::chrono::milliseconds window, std::vector<Aggregation> aggregations);
+
+        /// Adds a point
+        /// \return points of completed windows
+        std::vector<Point> add(Point&& point);
+
+        /// Returns the points of all open windows
+        std::vector<Point> flush();
+
+        /// Number of series with an open window
+        std::size_t activeSeries() const;
+
+    private:
+        using TimePoint = std::chrono::time_point<std::chrono::system_clock>;
+
+        struct FieldState
+        {
+            std::string name;
+            bool numeric;
+            std::uint64_t count;
+            double sum;
+            double min;
+            double max;
+            Point::FieldValue last;
+        };
+
+        struct Window
+        {
+            std::string measurement;
+            Point::TagSet tags;
+            TimePoint start;
+            std::vector<FieldState> fields;
+        };
+
+        TimePoint windowOf(TimePoint timestamp) const;
+        void aggregate(Window& window, const Point& point) const;
+        Point toPoint(const Window& window) const;
+
+        std::chrono::milliseconds window_;
+        std::vector<Aggregation> aggregations_;
+        std::unordered_map<std::string, Window> series_;
+        TimePoint latestWindow_;
+    };
+}
+
+#endif // INFLUXDATA_AGGREGATOR_H
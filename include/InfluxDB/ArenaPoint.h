@@ -0,0 +1,126 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INFLUXDATA_ARENAPOINT_H
+#define INFLUXDATA_ARENAPOINT_H
+
+#include <chrono>
+#include <deque>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "InfluxDB/LineWriter.h"
+#include "InfluxDB/Point.h"
+#include "InfluxDB/influxdb_export.h"
+
+namespace influxdb
+{
+    /// \brief Point allocating its measurement, tags and fields from a memory resource
+    ///
+    /// Same contents as Point, but the storage comes from the given resource,
+    /// eg. a std::pmr::monotonic_buffer_resource reused by a hot write path, so
+    /// building a point doesn't hit the global heap. InfluxDB serializes it
+    /// directly on write; the resource may be released afterwards:
+    ///
+    ///     std::array<std::byte, 4096> buffer;
+    ///     std::pmr::monotonic_buffer_resource arena{buffer.data(), buffer.size()};
+    ///     db->write(ArenaPoint{"cpu", &arena}.addTag("host", "localhost").addField("usage", 0.64));
+    ///     arena.release();
+    class INFLUXDB_EXPORT ArenaPoint
+    {
+    public:
+        using TimePoint = Point::TimePoint;
+        using FieldValue = std::variant<long long int, unsigned long long int, double, bool, std::pmr::string>;
+        using FieldSet = std::pmr::deque<std::pair<std::pmr::string, FieldValue>>;
+        using TagSet = std::pmr::deque<std::pair<std::pmr::string, std::pmr::string>>;
+
+        /// Constructs point based on measurement name, timestamped by the current time
+        /// \param measurement
+        /// \param resource     the point allocates from; must outlive the point
+        ArenaPoint(std::string_view measurement, std::pmr::memory_resource* resource);
+
+        /// Constructs point with the given timestamp, without reading the clock;
+        /// without timestamp (std::nullopt) the server assigns its time on write
+        ArenaPoint(std::string_view measurement, std::optional<TimePoint> timestamp, std::pmr::memory_resource* resource);
+
+        /// Adds a tag
+        ArenaPoint&& addTag(std::string_view key, std::string_view value);
+
+        /// Adds field; string values are copied into the memory resource
+        ArenaPoint&& addField(std::string_view name, const Point::FieldValue& value);
+        ArenaPoint&& addField(std::string_view name, std::string_view value);
+
+        template <class T>
+        ArenaPoint&& addField(std::string_view name, const T& value)
+        {
+            if constexpr (std::is_convertible_v<const T&, std::string_view>)
+            {
+                return addField(name, std::string_view{value});
+            }
+            else
+            {
+                return addField(name, Point::FieldValue{value});
+            }
+        }
+
+        /// Sets custom timestamp
+        ArenaPoint&& setTimestamp(TimePoint timestamp);
+
+        /// Name getter
+        std::string_view getName() const;
+
+        /// Timestamp getter, epoch if the point has no timestamp
+        TimePoint getTimestamp() const;
+
+        /// Whether the point has a timestamp
+        bool hasTimestamp() const;
+
+        /// Get Tag Set
+        const TagSet& getTagSet() const;
+
+        /// Get Field Set
+        const FieldSet& getFieldSet() const;
+
+        /// Memory resource the point allocates from
+        std::pmr::memory_resource* getResource() const;
+
+        /// Appends the point as line protocol
+        /// \param writer
+        void formatTo(LineWriter& writer) const;
+
+        /// Converts to a dynamic point, eg. for aggregation or batch coalescing
+        Point toPoint() const;
+
+    private:
+        std::pmr::string measurement_;
+        std::optional<TimePoint> timestamp_;
+        TagSet tags_;
+        FieldSet fields_;
+    };
+}
+
+#endif // INFLUXDATA_ARENAPOINT_H
@@ -0,0 +1,74 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INFLUXDATA_COARSECLOCK_H
+#define INFLUXDATA_COARSECLOCK_H
+
+#include "InfluxDB/influxdb_export.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace influxdb
+{
+    /// \brief Wall clock updated by a background thread at a fixed granularity
+    ///
+    /// Reading it is a single atomic load instead of a clock read, for
+    /// timestamps which don't need to be more precise than the granularity
+    /// (eg. at millisecond TimePrecision). The time lags behind by up to the
+    /// granularity; points of the same series written within one granularity
+    /// get the same timestamp and thus overwrite each other on the server.
+    class INFLUXDB_EXPORT CoarseClock
+    {
+    public:
+        using TimePoint = std::chrono::time_point<std::chrono::system_clock>;
+
+        /// Constructor, starts the background thread
+        /// \param granularity   update interval
+        /// \throw InfluxDBException     if granularity is not positive
+        explicit CoarseClock(std::chrono::microseconds granularity = std::chrono::milliseconds{1});
+        ~CoarseClock();
+
+        CoarseClock(const CoarseClock&) = delete;
+        CoarseClock& operator=(const CoarseClock&) = delete;
+
+        /// Time of the last update
+        TimePoint now() const noexcept;
+
+        /// Update interval
+        std::chrono::microseconds granularity() const noexcept;
+
+    private:
+        void update();
+
+        std::chrono::microseconds granularity_;
+        std::atomic<std::chrono::system_clock::rep> now_;
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        bool stop_;
+        std::thread thread_;
+    };
+}
+
+#endif // INFLUXDATA_COARSECLOCK_H
@@ -0,0 +1,108 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INFLUXDATA_COLUMNARRESULT_H
+#define INFLUXDATA_COLUMNARRESULT_H
+
+#include "InfluxDB/InfluxDBException.h"
+#include "InfluxDB/influxdb_export.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace influxdb
+{
+    /// \brief Column of a columnar query result
+    struct INFLUXDB_EXPORT Column
+    {
+        using TimeStamp = std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds>;
+        using Values = std::variant<std::vector<std::int64_t>,
+                                    std::vector<std::uint64_t>,
+                                    std::vector<double>,
+                                    std::vector<bool>,
+                                    std::vector<std::string>,
+                                    std::vector<TimeStamp>>;
+
+        std::string name;
+        Values values;
+
+        /// Validity per row, empty if the column has no null values
+        std::vector<bool> validity;
+
+        /// Number of rows
+        std::size_t size() const;
+
+        /// Returns whether the value of the row is null (a default value is stored instead)
+        bool isNull(std::size_t row) const;
+    };
+
+    /// \brief Query result in columnar layout, eg. decoded from Arrow record batches
+    ///
+    /// Integer columns of any width are widened to 64 bit, floating point columns
+    /// to double and timestamps to nanoseconds; dictionary encoded columns are
+    /// stored decoded.
+    class INFLUXDB_EXPORT ColumnarResult
+    {
+    public:
+        ColumnarResult() = default;
+        explicit ColumnarResult(std::vector<Column> columns);
+
+        /// Number of rows
+        std::size_t rows() const;
+
+        const std::vector<Column>& columns() const;
+
+        /// Returns the column of the given name
+        /// \throw InfluxDBException	if there's no such column
+        const Column& column(std::string_view name) const;
+
+        /// Returns the values of the given column
+        /// \throw InfluxDBException	if there's no such column or it's of another type
+        template <class T>
+        const std::vector<T>& values(std::string_view name) const
+        {
+            const auto& col = column(name);
+
+            if (const auto* values = std::get_if<std::vector<T>>(&col.values); values != nullptr)
+            {
+                return *values;
+            }
+            throw InfluxDBException{"Column '" + col.name + "' is of another type"};
+        }
+
+    private:
+        std::vector<Column> columns_;
+    };
+
+    /// Decodes the record batches of an Arrow IPC stream (eg. the payload of Arrow Flight)
+    /// \throw InfluxDBException	if decoding fails or built without Arrow support
+    INFLUXDB_EXPORT ColumnarResult readArrowStream(std::string_view data);
+
+    /// Decodes the record batches of an Arrow IPC file
+    /// \throw InfluxDBException	if decoding fails or built without Arrow support
+    INFLUXDB_EXPORT ColumnarResult readArrowFile(const std::string& path);
+}
+
+#endif // INFLUXDATA_COLUMNARRESULT_H
@@ -0,0 +1,154 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INFLUXDATA_TRANSPORTS_FAILOVER_H
+#define INFLUXDATA_TRANSPORTS_FAILOVER_H
+
+#include "InfluxDB/Transport.h"
+#include "InfluxDB/influxdb_export.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace influxdb
+{
+    struct FailoverOptions
+    {
+        /// Interval of the background health checks
+        std::chrono::milliseconds healthCheckInterval{std::chrono::seconds{1}};
+        /// Timeout set on the health check transports of the endpoints
+        std::chrono::milliseconds healthCheckTimeout{std::chrono::milliseconds{250}};
+    };
+
+    /// \brief Endpoint of a Failover
+    struct FailoverEndpoint
+    {
+        /// Transport of the requests
+        std::unique_ptr<Transport> transport;
+        /// Separate transport to the same server used only by the health checks,
+        /// eg. an own HTTP connection; health checks use the request transport if nullptr
+        std::unique_ptr<Transport> healthCheck{};
+    };
+}
+
+namespace influxdb::transports
+{
+    /// \brief Routes requests to the first healthy of an ordered list of endpoints
+    ///
+    /// A background thread checks all endpoints by ping(), so requests skip
+    /// unreachable endpoints without waiting for their timeout and return to
+    /// a preferred endpoint once it recovers. If a request fails with a
+    /// ConnectionException, the endpoint is marked unhealthy and the request
+    /// is repeated on the next endpoint right away; other errors (eg. an
+    /// invalid query) are passed on.
+    ///
+    /// Health checks use a separate transport per endpoint if given (as for
+    /// endpoints given by URL), with the timeout of
+    /// FailoverOptions::healthCheckTimeout, so they never wait for or delay
+    /// requests. Otherwise they share the request transport and check an
+    /// endpoint only while it's unhealthy, when requests skip it; a failing
+    /// request detects an unreachable healthy endpoint. Endpoints (or their
+    /// health check transports) must support ping().
+    class INFLUXDB_EXPORT Failover : public Transport
+    {
+    public:
+        /// Constructor
+        /// \param endpoints     transports in order of preference, initially assumed healthy
+        /// \param options
+        /// \throw InfluxDBException     if there are no endpoints or one is nullptr
+        explicit Failover(std::vector<std::unique_ptr<Transport>> endpoints, FailoverOptions options = {});
+
+        /// Constructor, creates a request and a separate health check transport per URL
+        /// \param urls         of the endpoints in order of preference (eg. http URLs), initially assumed healthy
+        /// \param options
+        /// \throw InfluxDBException     if there are no URLs, a URL is invalid or its
+        ///                              transport doesn't support setTimeout()
+        explicit Failover(const std::vector<std::string>& urls, FailoverOptions options = {});
+
+        /// Constructor
+        /// \param endpoints     endpoints in order of preference, initially assumed healthy
+        /// \param options
+        /// \throw InfluxDBException     if there are no endpoints, one is nullptr or a
+        ///                              health check transport doesn't support setTimeout()
+        explicit Failover(std::vector<FailoverEndpoint> endpoints, FailoverOptions options = {});
+        ~Failover() override;
+
+        Failover(const Failover&) = delete;
+        Failover& operator=(const Failover&) = delete;
+
+        /// \throw InfluxDBException     if no endpoint is healthy, with the last error of an endpoint
+        void send(std::string&& message) override;
+        std::string query(const std::string& query) override;
+        void queryChunked(const std::string& query, std::size_t chunkSize, const std::function<void(std::string_view)>& onChunk) override;
+        std::string queryArrow(const std::string& query) override;
+        std::string execute(const std::string& cmd) override;
+
+        void createDatabase() override;
+        void setProxy(const Proxy& proxy) override;
+        void setTimePrecision(TimePrecision precision) override;
+        void setQueryEpoch(TimePrecision epoch) override;
+        void setTimeout(std::chrono::milliseconds timeout) override;
+
+        /// True if any endpoint is healthy
+        bool ping() override;
+
+        /// Index of the endpoint requests are routed to, none if all are unhealthy
+        std::optional<std::size_t> activeEndpoint() const;
+
+    private:
+        struct Endpoint
+        {
+            std::unique_ptr<Transport> transport;
+            std::unique_ptr<Transport> healthCheck;
+            std::mutex transportMutex{};
+            std::atomic<bool> healthy{true};
+        };
+
+        static std::optional<std::string> reachabilityError(Transport& transport);
+        static std::optional<std::string> healthError(Endpoint& endpoint);
+        void checkHealth();
+        void setLastError(const std::string& error);
+
+        template <class Function>
+        auto route(Function function);
+
+        template <class Function>
+        void forEachEndpoint(Function function);
+
+        std::vector<std::unique_ptr<Endpoint>> endpoints_;
+        FailoverOptions options_;
+        std::mutex errorMutex_;
+        std::string lastError_;
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        bool stop_;
+        std::thread healthCheckThread_;
+    };
+}
+
+#endif // INFLUXDATA_TRANSPORTS_FAILOVER_H
@@ -0,0 +1,134 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INFLUXDATA_TRANSPORTS_FANOUT_H
+#define INFLUXDATA_TRANSPORTS_FANOUT_H
+
+#include "InfluxDB/Transport.h"
+#include "InfluxDB/RetryPolicy.h"
+#include "InfluxDB/influxdb_export.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace influxdb
+{
+    struct FanOutOptions
+    {
+        /// Messages queued per replica, the oldest are dropped first
+        std::size_t maxQueuedMessages{10000};
+
+        /// Retry of sends failing transiently (connection errors and retryable
+        /// statuses) per replica; the message is dropped after the last attempt,
+        /// other failures drop it at once
+        RetryPolicy retryPolicy{.maxAttempts = 5};
+    };
+
+    /// Delivery state of a replica
+    struct FanOutStats
+    {
+        /// Messages queued or being sent
+        std::size_t pending;
+
+        /// Messages sent successfully
+        std::size_t sent;
+
+        /// Messages dropped due to the queue size or failed retries
+        std::size_t dropped;
+    };
+}
+
+namespace influxdb::transports
+{
+    /// \brief Replicates writes to multiple transports
+    ///
+    /// Each message is stored once and shared by the queues of all replicas.
+    /// Every replica is sent to by its own thread with its own retry state, so a
+    /// slow or failing replica doesn't stall the others nor the caller.
+    ///
+    /// Queries are served by the first replica; settings are applied to all.
+    /// Messages still queued on destruction are dropped, see drain().
+    class INFLUXDB_EXPORT FanOut : public Transport
+    {
+    public:
+        /// Constructor
+        /// \param replicas  transports written to
+        /// \param options
+        /// \throw InfluxDBException     if there are no replicas or one is nullptr
+        explicit FanOut(std::vector<std::unique_ptr<Transport>> replicas, FanOutOptions options = {});
+        ~FanOut() override;
+
+        FanOut(const FanOut&) = delete;
+        FanOut& operator=(const FanOut&) = delete;
+
+        /// Queues the message for all replicas
+        void send(std::string&& message) override;
+
+        std::string query(const std::string& query) override;
+        void queryChunked(const std::string& query, std::size_t chunkSize, const std::function<void(std::string_view)>& onChunk) override;
+        std::string queryArrow(const std::string& query) override;
+        std::string execute(const std::string& cmd) override;
+        void createDatabase() override;
+        void setProxy(const Proxy& proxy) override;
+        void setTimePrecision(TimePrecision precision) override;
+        void setQueryEpoch(TimePrecision epoch) override;
+        void setTimeout(std::chrono::milliseconds timeout) override;
+        bool ping() override;
+
+        /// Waits until all queued messages are sent or dropped
+        /// \return false if messages are still pending after the timeout
+        bool drain(std::chrono::milliseconds timeout);
+
+        /// Delivery state of the replica at the given index
+        FanOutStats stats(std::size_t replica) const;
+
+    private:
+        struct Replica
+        {
+            std::unique_ptr<Transport> transport;
+            std::mutex transportMutex{};
+            mutable std::mutex mutex{};
+            std::condition_variable condition{};
+            std::deque<std::shared_ptr<const std::string>> queue{};
+            bool sending{false};
+            std::size_t sent{0};
+            std::size_t dropped{0};
+            bool stop{false};
+            std::thread worker{};
+        };
+
+        void deliver(Replica& replica);
+
+        template <class Function>
+        void forEachReplica(Function function);
+
+        std::vector<std::unique_ptr<Replica>> replicas_;
+        FanOutOptions options_;
+    };
+}
+
+#endif // INFLUXDATA_TRANSPORTS_FANOUT_H
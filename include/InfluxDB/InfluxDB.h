@@ -28,18 +28,34 @@
 #ifndef INFLUXDATA_INFLUXDB_H
 #define INFLUXDATA_INFLUXDB_H
 
+#include <chrono>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 #include <deque>
+#include <optional>
+#include <unordered_map>
 
 #include "InfluxDB/Transport.h"
+#include "InfluxDB/Aggregator.h"
 #include "InfluxDB/Point.h"
+#include "InfluxDB/Metrics.h"
+#include "InfluxDB/QueryCache.h"
 #include "InfluxDB/TimePrecision.h"
+#include "InfluxDB/Tracer.h"
+#include "InfluxDB/TypedPoint.h"
 #include "InfluxDB/influxdb_export.h"
 
 namespace influxdb
 {
+    class ArenaPoint;
+
+    namespace internal
+    {
+        class WorkerPool;
+    }
+
     class INFLUXDB_EXPORT InfluxDB
     {
     public:
@@ -52,6 +68,8 @@ namespace influxdb
         /// Constructor required valid transport
         explicit InfluxDB(std::unique_ptr<Transport> transport);
 
+        ~InfluxDB();
+
         /// Writes a point
         /// \param point
         void write(Point&& point);
@@ -60,9 +78,47 @@ namespace influxdb
         /// \param point
         void write(std::vector<Point>&& points);
 
+        /// Writes a typed point, serialized directly into the batch in write
+        /// order; it's converted to a Point if aggregation, batch coalescing or
+        /// series ordering is enabled
+        /// \param point
+        template <FixedString Measurement, class TagList, class FieldList>
+        void write(const TypedPoint<Measurement, TagList, FieldList>& point)
+        {
+            if (mAggregator || mIsBatchCoalescing || mIsSeriesOrdering)
+            {
+                write(point.toPoint());
+            }
+            else
+            {
+                writeLine([&point](LineWriter& writer)
+                          { point.formatTo(writer); });
+            }
+        }
+
+        /// Writes a point allocated from a memory resource, serialized directly
+        /// into the batch; the resource may be released after the call. It's
+        /// converted to a Point if aggregation, batch coalescing or series
+        /// ordering is enabled
+        /// \param point
+        void write(const ArenaPoint& point);
+
         /// Queries InfluxDB database
         std::vector<Point> query(const std::string& query);
 
+        /// Queries InfluxDB database with one or more statements (separated by ';')
+        /// in a single request
+        /// \return points of each statement, in order of the statements; empty if a statement has no result
+        /// \throw InfluxDBException     if a statement fails
+        std::vector<std::vector<Point>> queryStatements(const std::string& query);
+
+        /// Queries InfluxDB database in chunks and passes each point as it arrives,
+        /// so the complete result never has to be held in memory
+        /// \param query
+        /// \param onPoint     called for every point of the result
+        /// \param chunkSize   number of points per chunk sent by the server
+        void queryStream(const std::string& query, const std::function<void(Point&&)>& onPoint, std::size_t chunkSize = 10000);
+
         /// Create InfluxDB database if does not exists
         void createDatabaseIfNotExists();
 
@@ -79,6 +135,17 @@ namespace influxdb
         /// Clears the point batch
         void clearBatch();
 
+        /// Coalesces points of the same series and timestamp within a batch,
+        /// as the server keeps only the last value of each field: fields are
+        /// merged into the earlier point in place, later values win
+        /// \param enabled
+        void setBatchCoalescing(bool enabled);
+
+        /// Writes tags ordered by key and the points of a batch grouped by
+        /// series, sorted by measurement and tags, which saves the server sorting
+        /// \param enabled
+        void setSeriesOrdering(bool enabled);
+
         /// Adds a global tag
         /// \param name
         /// \param value
@@ -92,32 +159,121 @@ namespace influxdb
         /// \param precision
         void setTimePrecision(TimePrecision precision);
 
+        /// Requests epoch timestamps in query results instead of RFC3339 strings
+        /// \param epoch
+        void setQueryEpoch(TimePrecision epoch);
+
+        /// Decodes the series of query results in parallel, by threads started
+        /// once and reused by all queries of this instance
+        /// \param threads  maximum number of decoding threads, 1 decodes sequentially
+        void setQueryDecodeThreads(std::size_t threads);
+
+        /// Serves queries through the cache; it may be shared only between instances
+        /// of the same database, as responses are keyed by the query, not the
+        /// server or database. Only single SELECT and SHOW statements are cached,
+        /// see QueryCache::isCacheable(). nullptr disables caching
+        /// \param cache
+        void setQueryCache(std::shared_ptr<QueryCache> cache);
+
+        /// Traces serialization, transmission, query requests and response decoding;
+        /// nullptr (default) disables tracing
+        /// \param tracer
+        void setTracer(std::shared_ptr<Tracer> tracer);
+
+        /// Aggregates written points per series and window before batching or
+        /// transmitting them; open windows of a replaced aggregator are written
+        /// first, nullptr (default) disables aggregation
+        /// \param aggregator
+        void setAggregator(std::unique_ptr<Aggregator> aggregator);
+
+        /// Writes the points of all open aggregation windows, eg. before shutdown;
+        /// if batching is enabled they are added to the batch
+        void flushAggregation();
+
         /// Check instance is up and running
         bool ping();
 
+        /// Returns a snapshot of the write path metrics; all zero if the
+        /// library is built without metrics (INFLUXCXX_WITH_METRICS=OFF)
+        MetricsSnapshot metrics() const;
+
+        /// Periodically writes the metrics as a point through this instance, by
+        /// the first write or flush after the interval elapsed; counters are
+        /// cumulative since construction
+        /// \param interval
+        /// \param prototype   measurement and tags of the point (eg. transport type and host)
+        void setSelfMonitoring(std::chrono::milliseconds interval, Point prototype = Point{"influxdb_cxx_stats"});
+
+        /// Stops writing the metrics
+        void disableSelfMonitoring();
+
     private:
         void addPointToBatch(Point&& point);
-        std::string joinLineProtocolBatch() const;
+        void writeLine(const std::function<void(LineWriter&)>& format);
+        void writePoints(std::vector<Point>&& points);
+        void emitSelfMonitoring();
+        std::string joinLineProtocolBatch();
 
         /// line protocol batch to be written
         std::deque<Point> mPointBatch;
 
+        /// Serialized points of the batch preceding mPointBatch, each terminated
+        /// by newline; points are serialized here once a typed point is written
+        std::string mLineBatch;
+
+        /// Number of points in mLineBatch
+        std::size_t mLineBatchSize;
+
         /// Flag stating whether point buffering is enabled
         bool mIsBatchingActivated;
 
         /// Points batch size
         std::size_t mBatchSize;
 
+        /// Flag stating whether points of the same series and timestamp are coalesced
+        bool mIsBatchCoalescing;
+
+        /// Position in the batch by series key and timestamp, if coalescing
+        std::unordered_map<std::string, std::size_t> mBatchIndex;
+
+        /// Flag stating whether tags and batches are written in series order
+        bool mIsSeriesOrdering;
+
         /// Underlying transport UDP/HTTP/Unix socket
         std::unique_ptr<Transport> mTransport;
 
-        /// Transmits string over transport
-        void transmit(std::string&& point);
+        /// Transmits string of the given number of points over transport
+        void transmit(std::string&& point, std::size_t points);
 
         /// List of global tags
         std::string mGlobalTags;
 
         TimePrecision timePrecision;
+
+        /// Epoch precision of query results, RFC3339 if not set
+        std::optional<TimePrecision> mQueryEpoch;
+
+        /// Threads decoding query results, sequential if not set
+        std::unique_ptr<internal::WorkerPool> mQueryDecodePool;
+
+        /// Optional cache of query responses
+        std::shared_ptr<QueryCache> mQueryCache;
+
+        /// Write path metrics
+        Metrics mMetrics;
+
+        /// Measurement and tags of the self monitoring point, disabled if not set
+        std::optional<Point> mSelfMonitoringPoint;
+
+        /// Interval and next due time of self monitoring
+        std::chrono::milliseconds mSelfMonitoringInterval;
+        std::chrono::steady_clock::time_point mNextSelfMonitoring;
+
+        /// Optional tracer of operations
+        std::shared_ptr<Tracer> mTracer;
+
+        /// Optional aggregation stage in front of batching
+        std::unique_ptr<Aggregator> mAggregator;
     };
 
 } // namespace influxdb
@@ -26,8 +26,11 @@
 #include "InfluxDB/InfluxDB.h"
 #include "InfluxDB/Transport.h"
 #include "InfluxDB/Proxy.h"
+#include "InfluxDB/RetryPolicy.h"
 #include "InfluxDB/influxdb_export.h"
 #include <chrono>
+#include <functional>
+#include <string_view>
 
 namespace influxdb
 {
@@ -41,6 +44,10 @@ namespace influxdb
         InfluxDBBuilder&& setProxy(const Proxy& proxy);
         InfluxDBBuilder&& setTimeout(std::chrono::milliseconds timeout);
         InfluxDBBuilder&& setVerifyCertificate(bool verify);
+        InfluxDBBuilder&& setHttp2(bool enable);
+        InfluxDBBuilder&& setBucket(const std::string& organization, const std::string& bucket);
+        InfluxDBBuilder&& setRetryPolicy(const RetryPolicy& policy);
+        InfluxDBBuilder&& setPartialWriteHandler(std::function<void(std::string_view line, const std::string& error)> handler);
 
         static InfluxDBBuilder http(const std::string& url);
 
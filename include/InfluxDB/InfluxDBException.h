@@ -28,6 +28,7 @@
 #ifndef INFLUXDATA_EXCEPTION_H
 #define INFLUXDATA_EXCEPTION_H
 
+#include <memory>
 #include <stdexcept>
 #include <string>
 
@@ -45,6 +46,56 @@ namespace influxdb
         }
     };
 
+    /// \brief Server couldn't be reached, eg. a connection error or timeout; the
+    /// request may be repeated on another server
+    class INFLUXDB_EXPORT ConnectionException : public InfluxDBException
+    {
+    public:
+        explicit ConnectionException(const std::string& message)
+            : InfluxDBException(message)
+        {
+        }
+    };
+
+    /// \brief Request answered with an error status by the server
+    class INFLUXDB_EXPORT RequestFailedException : public InfluxDBException
+    {
+    public:
+        RequestFailedException(const std::string& message, long status)
+            : InfluxDBException(message), status_(status)
+        {
+        }
+
+        /// HTTP status of the response, see RetryPolicy::isRetryableStatus()
+        long status() const noexcept
+        {
+            return status_;
+        }
+
+    private:
+        long status_;
+    };
+
+    /// \brief Failed send of which a part was delivered, eg. by a router to some of its backends
+    class INFLUXDB_EXPORT PartialSendException : public InfluxDBException
+    {
+    public:
+        PartialSendException(const std::string& message, std::string undelivered)
+            : InfluxDBException(message), undelivered_(std::make_shared<const std::string>(std::move(undelivered)))
+        {
+        }
+
+        /// Lines which weren't delivered; only these may be sent again, the
+        /// others would be duplicated
+        const std::string& undelivered() const noexcept
+        {
+            return *undelivered_;
+        }
+
+    private:
+        std::shared_ptr<const std::string> undelivered_;
+    };
+
 } // namespace influxdb
 
 #endif // INFLUXDATA_EXCEPTION_H
@@ -59,10 +59,14 @@ namespace influxdb
         /// \throw InfluxDBException     if unrecognised backend, missing protocol or unsupported proxy
         static std::unique_ptr<InfluxDB> Get(const std::string& url, const Proxy& proxy);
 
-    private:
-        ///\return  backend based on provided URL
+        /// Transport factory
+        /// Provides transport for the given URL, eg. to be wrapped by another transport
+        /// \param url   URL defining transport details
+        /// \throw InfluxDBException     if unrecognised backend or missing protocol
         static std::unique_ptr<Transport> GetTransport(const std::string& url);
 
+    private:
+
         /// Private constructor disallows to create instance of Factory
         InfluxDBFactory() = default;
     };
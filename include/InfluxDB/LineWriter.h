@@ -0,0 +1,106 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INFLUXDATA_LINEWRITER_H
+#define INFLUXDATA_LINEWRITER_H
+
+#include "InfluxDB/TimePrecision.h"
+#include "InfluxDB/influxdb_export.h"
+#include <chrono>
+#include <string>
+#include <string_view>
+
+namespace influxdb
+{
+    class LineProtocol;
+
+    /// \brief Appends the elements of a point as line protocol, formatted the
+    /// same way as points written by InfluxDB
+    ///
+    /// Elements must be appended in line order: the measurement, the tags, the
+    /// fields and the timestamp. Keys are expected to be escaped already (eg.
+    /// at compile time by TypedPoint) unless passed as Unescaped; values are
+    /// escaped by the writer.
+    class INFLUXDB_EXPORT LineWriter
+    {
+    public:
+        using TimePoint = std::chrono::time_point<std::chrono::system_clock>;
+
+        /// Measurement or key to be escaped by the writer, eg. of a point built at runtime
+        struct Unescaped
+        {
+            std::string_view value;
+        };
+
+        /// Constructor
+        /// \param line         buffer the line is appended to
+        /// \param precision    of the timestamp
+        /// \param globalTags   escaped tags following the measurement
+        LineWriter(std::string& line, TimePrecision precision, std::string_view globalTags = {});
+
+        /// Appends the measurement, followed by the global tags
+        void measurement(std::string_view escapedName);
+        void measurement(Unescaped name);
+
+        /// Appends a tag; tags with empty value are omitted, as for Point
+        void tag(std::string_view escapedKey, std::string_view value);
+        void tag(Unescaped key, std::string_view value);
+
+        /// Appends a field
+        void field(std::string_view escapedKey, long long int value);
+        void field(std::string_view escapedKey, unsigned long long int value);
+        void field(std::string_view escapedKey, double value);
+        void field(std::string_view escapedKey, bool value);
+        void field(std::string_view escapedKey, std::string_view value);
+
+        void field(std::string_view escapedKey, const char* value)
+        {
+            field(escapedKey, std::string_view{value});
+        }
+
+        void field(Unescaped key, long long int value);
+        void field(Unescaped key, unsigned long long int value);
+        void field(Unescaped key, double value);
+        void field(Unescaped key, bool value);
+        void field(Unescaped key, std::string_view value);
+
+        /// Appends the timestamp
+        void timestamp(TimePoint time);
+
+    private:
+        friend class LineProtocol;
+
+        using TimestampFormatter = void (*)(std::string&, TimePoint);
+
+        LineWriter(std::string& line, TimestampFormatter formatTimestamp, std::string_view globalTags);
+
+        void fieldKey(std::string_view escapedKey);
+        void fieldKey(Unescaped key);
+
+        std::string& line_;
+        TimestampFormatter formatTimestamp_;
+        std::string_view globalTags_;
+        bool hasFields_;
+    };
+}
+
+#endif // INFLUXDATA_LINEWRITER_H
@@ -0,0 +1,141 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INFLUXDATA_METRICS_H
+#define INFLUXDATA_METRICS_H
+
+#include "InfluxDB/influxdb_export.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace influxdb
+{
+    /// \brief Lock-free latency histogram with logarithmic buckets
+    ///
+    /// Bucket 0 counts latencies below 1 µs, bucket i those within [2^(i-1), 2^i) µs;
+    /// the last bucket counts everything above.
+    class INFLUXDB_EXPORT LatencyHistogram
+    {
+    public:
+        static constexpr std::size_t bucketCount{32};
+        using Buckets = std::array<std::uint64_t, bucketCount>;
+
+        void record(std::chrono::nanoseconds latency) noexcept
+        {
+            buckets_[bucketOf(latency)].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        Buckets snapshot() const noexcept;
+
+        /// Returns the bucket of the latency
+        static std::size_t bucketOf(std::chrono::nanoseconds latency) noexcept;
+
+        /// Returns the upper bound of the bucket containing the quantile (0..1)
+        /// of the counted latencies, zero if there are none
+        static std::chrono::microseconds quantile(const Buckets& buckets, double q) noexcept;
+
+    private:
+        std::array<std::atomic<std::uint64_t>, bucketCount> buckets_{};
+    };
+
+    /// \brief Point in time copy of the metrics
+    struct INFLUXDB_EXPORT MetricsSnapshot
+    {
+        /// Points passed to write()
+        std::uint64_t pointsWritten{0};
+
+        /// Bytes of line protocol serialized
+        std::uint64_t bytesSerialized{0};
+
+        /// Batches flushed and their total number of points
+        std::uint64_t batchesFlushed{0};
+        std::uint64_t batchedPoints{0};
+
+        /// Calls of the transport's send() and those failed
+        std::uint64_t transmits{0};
+        std::uint64_t transmitErrors{0};
+
+        /// Points lost by failed transmissions
+        std::uint64_t pointsDropped{0};
+
+        /// Latency of flushing a batch (serialization and transmission)
+        LatencyHistogram::Buckets flushLatency{};
+
+        /// Latency of the transport's send()
+        LatencyHistogram::Buckets transmitLatency{};
+    };
+
+    /// \brief Counters of the write path, updated lock-free and readable from any thread
+    class INFLUXDB_EXPORT Metrics
+    {
+    public:
+        void addPointsWritten(std::uint64_t points) noexcept
+        {
+            pointsWritten_.fetch_add(points, std::memory_order_relaxed);
+        }
+
+        void addBytesSerialized(std::uint64_t bytes) noexcept
+        {
+            bytesSerialized_.fetch_add(bytes, std::memory_order_relaxed);
+        }
+
+        void addBatchFlushed(std::uint64_t points, std::chrono::nanoseconds latency) noexcept
+        {
+            batchesFlushed_.fetch_add(1, std::memory_order_relaxed);
+            batchedPoints_.fetch_add(points, std::memory_order_relaxed);
+            flushLatency_.record(latency);
+        }
+
+        void addTransmit(std::chrono::nanoseconds latency, bool failed) noexcept
+        {
+            transmits_.fetch_add(1, std::memory_order_relaxed);
+            if (failed)
+            {
+                transmitErrors_.fetch_add(1, std::memory_order_relaxed);
+            }
+            transmitLatency_.record(latency);
+        }
+
+        void addPointsDropped(std::uint64_t points) noexcept
+        {
+            pointsDropped_.fetch_add(points, std::memory_order_relaxed);
+        }
+
+        MetricsSnapshot snapshot() const noexcept;
+
+    private:
+        std::atomic<std::uint64_t> pointsWritten_{0};
+        std::atomic<std::uint64_t> bytesSerialized_{0};
+        std::atomic<std::uint64_t> batchesFlushed_{0};
+        std::atomic<std::uint64_t> batchedPoints_{0};
+        std::atomic<std::uint64_t> transmits_{0};
+        std::atomic<std::uint64_t> transmitErrors_{0};
+        std::atomic<std::uint64_t> pointsDropped_{0};
+        LatencyHistogram flushLatency_;
+        LatencyHistogram transmitLatency_;
+    };
+}
+
+#endif // INFLUXDATA_METRICS_H
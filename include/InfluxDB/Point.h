@@ -33,6 +33,8 @@
 #include <chrono>
 #include <variant>
 #include <deque>
+#include <memory>
+#include <optional>
 
 #include "InfluxDB/influxdb_export.h"
 
@@ -41,13 +43,21 @@ namespace influxdb
 
     static inline constexpr int defaultFloatsPrecision{18};
 
+    class CoarseClock;
+
     /// \brief Represents a point
     class INFLUXDB_EXPORT Point
     {
     public:
-        /// Constructs point based on measurement name
+        using TimePoint = std::chrono::time_point<std::chrono::system_clock>;
+
+        /// Constructs point based on measurement name, timestamped by the current time
         explicit Point(const std::string& measurement);
 
+        /// Constructs point with the given timestamp, without reading the clock;
+        /// without timestamp (std::nullopt) the server assigns its time on write
+        Point(const std::string& measurement, std::optional<TimePoint> timestamp);
+
         /// Adds a tags
         Point&& addTag(std::string_view key, std::string_view value);
 
@@ -61,9 +71,12 @@ namespace influxdb
         /// Name getter
         std::string getName() const;
 
-        /// Timestamp getter
+        /// Timestamp getter, epoch if the point has no timestamp
         std::chrono::time_point<std::chrono::system_clock> getTimestamp() const;
 
+        /// Whether the point has a timestamp
+        bool hasTimestamp() const;
+
         /// Fields getter
         std::string getFields() const;
 
@@ -81,12 +94,19 @@ namespace influxdb
         /// Precision for float fields
         static inline int floatsPrecision{defaultFloatsPrecision};
 
+        /// Timestamps points constructed without explicit timestamp by the coarse
+        /// clock instead of the system clock; nullptr (default) restores the
+        /// system clock. The clock is shared, so points constructed concurrently
+        /// keep it alive while it's replaced.
+        /// \param clock
+        static void setClock(std::shared_ptr<const CoarseClock> clock);
+
     protected:
         /// A name
         std::string mMeasurement;
 
-        /// A timestamp
-        std::chrono::time_point<std::chrono::system_clock> mTimestamp;
+        /// A timestamp, assigned by the server if not set
+        std::optional<TimePoint> mTimestamp;
 
         //// Tags
         TagSet mTags;
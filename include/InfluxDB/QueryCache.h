@@ -0,0 +1,96 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INFLUXDATA_QUERYCACHE_H
+#define INFLUXDATA_QUERYCACHE_H
+
+#include "InfluxDB/influxdb_export.h"
+#include <chrono>
+#include <functional>
+#include <future>
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace influxdb
+{
+    /// \brief Thread-safe cache of query responses
+    ///
+    /// Entries are keyed by the query string, expire after the time to live
+    /// and are evicted least recently used first once the byte budget is
+    /// exceeded. Concurrent requests of the same query share one execution.
+    /// A cache must only be shared between clients of the same database.
+    class INFLUXDB_EXPORT QueryCache
+    {
+    public:
+        /// Constructor
+        /// \param maxBytes   budget of cached queries and responses
+        /// \param timeToLive time a response is served from the cache
+        QueryCache(std::size_t maxBytes, std::chrono::milliseconds timeToLive);
+
+        /// Returns the cached response of the query or executes it
+        /// \param query
+        /// \param execute  performs the query if not cached
+        std::string get(const std::string& query, const std::function<std::string()>& execute);
+
+        /// Removes all cached responses
+        void clear();
+
+        /// Number of queries served from the cache or a shared execution
+        std::size_t hits() const;
+
+        /// Number of executed queries
+        std::size_t misses() const;
+
+        /// Size of cached queries and responses in bytes
+        std::size_t bytes() const;
+
+        /// Returns true for a single SELECT (without INTO) or SHOW statement;
+        /// other queries modify the database and must always be executed
+        static bool isCacheable(std::string_view query);
+
+    private:
+        struct Entry
+        {
+            std::string query;
+            std::string response;
+            std::chrono::steady_clock::time_point expiry;
+        };
+
+        void insert(const std::string& query, const std::string& response);
+        void evict(std::list<Entry>::iterator entry);
+
+        std::size_t maxBytes_;
+        std::chrono::milliseconds timeToLive_;
+        mutable std::mutex mutex_;
+        std::list<Entry> entries_;
+        std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+        std::unordered_map<std::string, std::shared_future<std::string>> pending_;
+        std::size_t bytes_;
+        std::size_t hits_;
+        std::size_t misses_;
+    };
+}
+
+#endif // INFLUXDATA_QUERYCACHE_H
@@ -0,0 +1,58 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INFLUXDATA_RETRYPOLICY_H
+#define INFLUXDATA_RETRYPOLICY_H
+
+#include "InfluxDB/influxdb_export.h"
+#include <chrono>
+#include <cstddef>
+
+namespace influxdb
+{
+    /// \brief Retry of transient failures with exponential backoff
+    struct INFLUXDB_EXPORT RetryPolicy
+    {
+        /// Maximum number of attempts including the first one, 1 disables retries
+        std::size_t maxAttempts{1};
+
+        /// Backoff before the first retry
+        std::chrono::milliseconds initialBackoff{100};
+
+        /// Upper limit of the backoff, also of the delay requested by a Retry-After header
+        std::chrono::milliseconds maxBackoff{10000};
+
+        /// Growth factor of the backoff per attempt
+        double multiplier{2.0};
+
+        /// Randomizes the backoff within [0, backoff] to spread retries of many clients
+        bool jitter{true};
+
+        /// Returns the backoff after the given failed attempt (starting at 1)
+        std::chrono::milliseconds backoff(std::size_t attempt) const;
+
+        /// Returns true for HTTP statuses of transient failures (eg. 503), which are retried
+        static bool isRetryableStatus(long status);
+    };
+}
+
+#endif // INFLUXDATA_RETRYPOLICY_H
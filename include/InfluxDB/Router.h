@@ -0,0 +1,110 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INFLUXDATA_TRANSPORTS_ROUTER_H
+#define INFLUXDATA_TRANSPORTS_ROUTER_H
+
+#include "InfluxDB/Transport.h"
+#include "InfluxDB/influxdb_export.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace influxdb
+{
+    /// Assignment of points to the backends of a router
+    enum class RoutingStrategy
+    {
+        /// Consistent hashing of measurement and tags
+        SeriesHash,
+        /// Consistent hashing of the measurement
+        MeasurementHash,
+        /// Points are distributed in turn
+        RoundRobin
+    };
+
+    /// Backend of a router, identified on the hash ring by its name
+    struct RouterBackend
+    {
+        std::string name;
+        std::unique_ptr<Transport> transport;
+    };
+}
+
+namespace influxdb::transports
+{
+    /// \brief Shards points across multiple backends
+    ///
+    /// Each message is split into its lines, which are assigned to a backend by
+    /// the strategy; every backend receives one message per sent message with
+    /// its points. Consistent hashing of named backends moves only the points
+    /// of the affected share of series if a backend is added or removed.
+    /// Series are hashed as written, so tags should be added in a consistent
+    /// order (or written by InfluxDB::setSeriesOrdering()).
+    ///
+    /// Settings are applied to all backends; queries are not supported, as a
+    /// query would need to be merged from all shards.
+    class INFLUXDB_EXPORT Router : public Transport
+    {
+    public:
+        /// Constructor
+        /// \param backends      transports of the shards, named by a stable identity
+        ///                      (eg. the host), which determines their share of series
+        /// \param strategy
+        /// \param virtualNodes  points on the hash ring per backend
+        /// \throw InfluxDBException     if there are no backends, one is nullptr or names are empty or not unique
+        explicit Router(std::vector<RouterBackend> backends, RoutingStrategy strategy = RoutingStrategy::SeriesHash, std::size_t virtualNodes = 64);
+
+        /// Constructor of backends identified by their index; removing a backend
+        /// other than the last one moves the series of the following backends
+        explicit Router(std::vector<std::unique_ptr<Transport>> backends, RoutingStrategy strategy = RoutingStrategy::SeriesHash, std::size_t virtualNodes = 64);
+
+        /// Sends the points of the message to their backends; all backends are
+        /// tried even if one fails
+        /// \throw PartialSendException  if some backends failed, with their points
+        /// \throw InfluxDBException     first failure if all backends failed
+        void send(std::string&& message) override;
+
+        void createDatabase() override;
+        void setProxy(const Proxy& proxy) override;
+        void setTimePrecision(TimePrecision precision) override;
+        void setQueryEpoch(TimePrecision epoch) override;
+
+        /// True if all backends are reachable
+        bool ping() override;
+
+        /// Index of the backend a line of line protocol is routed to by hashing
+        std::size_t backendOf(std::string_view line) const;
+
+    private:
+        std::vector<std::unique_ptr<Transport>> backends_;
+        RoutingStrategy strategy_;
+        /// Hash ring of virtual nodes and their backend, sorted by hash
+        std::vector<std::pair<std::uint64_t, std::size_t>> ring_;
+        std::size_t nextBackend_;
+    };
+}
+
+#endif // INFLUXDATA_TRANSPORTS_ROUTER_H
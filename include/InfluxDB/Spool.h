@@ -0,0 +1,155 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INFLUXDATA_TRANSPORTS_SPOOL_H
+#define INFLUXDATA_TRANSPORTS_SPOOL_H
+
+#include "InfluxDB/Transport.h"
+#include "InfluxDB/influxdb_export.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace influxdb
+{
+    struct SpoolOptions
+    {
+        /// Size cap of all segment files, the oldest segments are evicted first
+        std::size_t maxBytes{256 * 1024 * 1024};
+
+        /// Size at which a new segment file is started
+        std::size_t segmentBytes{16 * 1024 * 1024};
+
+        /// Interval of replay attempts while the transport fails
+        std::chrono::milliseconds retryInterval{std::chrono::seconds{1}};
+
+        /// Replay attempts of a message failing while the transport still
+        /// answers ping (eg. a parse error), after which the message is dropped
+        std::size_t maxRejections{3};
+
+        /// Called with each message dropped after maxRejections and its last error
+        std::function<void(std::string_view message, const std::string& error)> onRejected{};
+    };
+}
+
+namespace influxdb::transports
+{
+    /// \brief Durable on-disk spool in front of a transport
+    ///
+    /// Messages failing to send are appended to segment files and replayed in
+    /// order by a background thread once the transport recovers. While messages
+    /// are pending, new messages are appended to the spool as well. Each record
+    /// is length prefixed and checksummed; segments left from a previous run
+    /// are replayed on construction (at-least-once delivery). The replay
+    /// position is persisted after each message, so a restart resends at most
+    /// the message replayed when the previous run stopped.
+    ///
+    /// Failures are retried as long as the transport doesn't answer ping (or
+    /// doesn't support it). A message failing although it does is rejected
+    /// by the server and dropped after SpoolOptions::maxRejections attempts,
+    /// so it doesn't block the messages behind it. Of a partially delivered
+    /// message (PartialSendException) only the undelivered part is spooled.
+    class INFLUXDB_EXPORT Spool : public Transport
+    {
+    public:
+        /// Constructor
+        /// \param transport    wrapped transport
+        /// \param directory    directory of the segment files, created if missing
+        /// \param options
+        /// \throw InfluxDBException     if the directory is not accessible
+        Spool(std::unique_ptr<Transport> transport, const std::filesystem::path& directory, SpoolOptions options = {});
+        ~Spool() override;
+
+        Spool(const Spool&) = delete;
+        Spool& operator=(const Spool&) = delete;
+
+        /// Sends message, or appends it to the spool if pending or failed
+        /// \throw InfluxDBException     if writing the spool fails
+        void send(std::string&& message) override;
+
+        std::string query(const std::string& query) override;
+        void queryChunked(const std::string& query, std::size_t chunkSize, const std::function<void(std::string_view)>& onChunk) override;
+        std::string queryArrow(const std::string& query) override;
+        std::string execute(const std::string& cmd) override;
+        void createDatabase() override;
+        void setProxy(const Proxy& proxy) override;
+        void setTimePrecision(TimePrecision precision) override;
+        void setQueryEpoch(TimePrecision epoch) override;
+        bool ping() override;
+
+        /// Bytes of spooled messages not yet replayed
+        std::size_t pendingBytes() const;
+
+        /// Bytes of spooled messages dropped due to the size cap, corruption or rejection
+        std::size_t evictedBytes() const;
+
+    private:
+        struct Segment
+        {
+            std::uint64_t sequence;
+            std::filesystem::path path;
+            std::size_t size;
+        };
+
+        void append(const std::string& message);
+        void startSegment();
+        void evictOldestSegment();
+        void removeHeadSegment();
+        std::optional<std::string> readRecord(std::size_t& recordSize);
+        void loadCursor();
+        void saveCursor();
+        std::size_t pending() const;
+        bool isReachable();
+        void replay();
+
+        std::unique_ptr<Transport> transport_;
+        std::mutex transportMutex_;
+        std::filesystem::path directory_;
+        SpoolOptions options_;
+        mutable std::mutex mutex_;
+        std::condition_variable condition_;
+        std::deque<Segment> segments_;
+        std::ofstream writer_;
+        std::ifstream reader_;
+        std::uint64_t readerSequence_;
+        std::ofstream cursor_;
+        std::size_t readOffset_;
+        std::size_t totalBytes_;
+        std::size_t evictedBytes_;
+        std::size_t rejections_;
+        std::uint64_t nextSequence_;
+        bool stop_;
+        std::thread replayThread_;
+    };
+}
+
+#endif // INFLUXDATA_TRANSPORTS_SPOOL_H
@@ -0,0 +1,86 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INFLUXDATA_TRACER_H
+#define INFLUXDATA_TRACER_H
+
+#include "InfluxDB/influxdb_export.h"
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace influxdb
+{
+    /// Traced operations of the client
+    enum class TraceSpan
+    {
+        Serialize, ///< Formatting points to line protocol
+        Send,      ///< Transport::send()
+        Query,     ///< Query request through the transport
+        Decode     ///< Decoding of a query response
+    };
+
+    /// Returns the name of the span ("serialize", "send", "query", "decode")
+    INFLUXDB_EXPORT std::string_view toString(TraceSpan span);
+
+    /// \brief Receives the begin and end of spans of the client's operations
+    ///
+    /// Spans of a thread are properly nested; a tracer shared between
+    /// clients of different threads must be thread-safe.
+    class INFLUXDB_EXPORT Tracer
+    {
+    public:
+        virtual ~Tracer() = default;
+
+        virtual void begin(TraceSpan span) = 0;
+        virtual void end(TraceSpan span) = 0;
+    };
+
+    /// \brief Thread-safe tracer writing Chrome trace events (chrome://tracing, Perfetto)
+    class INFLUXDB_EXPORT ChromeTraceWriter : public Tracer
+    {
+    public:
+        /// Constructor
+        /// \param path     file the trace is written to, completed on destruction
+        /// \throw InfluxDBException	if the file can't be opened
+        explicit ChromeTraceWriter(const std::string& path);
+        ~ChromeTraceWriter() override;
+
+        ChromeTraceWriter(const ChromeTraceWriter&) = delete;
+        ChromeTraceWriter& operator=(const ChromeTraceWriter&) = delete;
+
+        void begin(TraceSpan span) override;
+        void end(TraceSpan span) override;
+
+    private:
+        void writeEvent(TraceSpan span, char phase);
+
+        std::mutex mutex_;
+        std::ofstream out_;
+        std::chrono::steady_clock::time_point start_;
+        bool firstEvent_;
+    };
+}
+
+#endif // INFLUXDATA_TRACER_H
@@ -32,6 +32,10 @@
 #include "InfluxDB/TimePrecision.h"
 #include "InfluxDB/influxdb_export.h"
 #include "InfluxDB/Proxy.h"
+#include <chrono>
+#include <functional>
+#include <string>
+#include <string_view>
 
 namespace influxdb
 {
@@ -53,6 +57,20 @@ namespace influxdb
             throw InfluxDBException{"Queries are not supported by the selected transport"};
         }
 
+        /// Sends request and passes each chunk of the response as it arrives
+        virtual void queryChunked([[maybe_unused]] const std::string& query, [[maybe_unused]] std::size_t chunkSize,
+                                  [[maybe_unused]] const std::function<void(std::string_view)>& onChunk)
+        {
+            throw InfluxDBException{"Chunked queries are not supported by the selected transport"};
+        }
+
+        /// Sends request and returns the result as Arrow IPC stream, eg. received by
+        /// an Arrow Flight client; decoded by readArrowStream()
+        virtual std::string queryArrow([[maybe_unused]] const std::string& query)
+        {
+            throw InfluxDBException{"Arrow queries are not supported by the selected transport"};
+        }
+
         /// Executes command
         virtual std::string execute([[maybe_unused]] const std::string& cmd)
         {
@@ -76,6 +94,18 @@ namespace influxdb
             throw InfluxDBException{"Time precision is not supported by the selected transport"};
         }
 
+        /// Requests query results with epoch timestamps of the given precision
+        virtual void setQueryEpoch([[maybe_unused]] TimePrecision epoch)
+        {
+            throw InfluxDBException{"Query epoch is not supported by the selected transport"};
+        }
+
+        /// Sets timeout of requests
+        virtual void setTimeout([[maybe_unused]] std::chrono::milliseconds timeout)
+        {
+            throw InfluxDBException{"Timeout is not supported by the selected transport"};
+        }
+
         virtual bool ping()
         {
             throw InfluxDBException{"Ping is not supported by the selected transport"};
@@ -0,0 +1,339 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INFLUXDATA_TYPEDPOINT_H
+#define INFLUXDATA_TYPEDPOINT_H
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "InfluxDB/LineWriter.h"
+#include "InfluxDB/Point.h"
+#include "InfluxDB/TimePrecision.h"
+
+namespace influxdb
+{
+    /// \brief String literal usable as template argument, eg. measurement, tag and field names
+    template <std::size_t N>
+    struct FixedString
+    {
+        constexpr FixedString(const char (&str)[N]) // NOLINT(google-explicit-constructor): converts literals
+        {
+            std::copy_n(str, N, value);
+        }
+
+        constexpr std::string_view view() const
+        {
+            return {value, N - 1};
+        }
+
+        char value[N]{};
+    };
+
+    /// Tag keys of a typed point, eg. Tags<"host", "region">
+    template <FixedString... Names>
+    struct Tags
+    {
+    };
+
+    /// Field key and value type of a typed point, eg. Field<"usage", double>
+    template <FixedString Name, class T>
+    struct Field
+    {
+    };
+
+    /// Fields of a typed point, eg. Fields<Field<"usage", double>, Field<"procs", std::int64_t>>
+    template <class... FieldTypes>
+    struct Fields
+    {
+    };
+
+    namespace internal
+    {
+        constexpr bool isAnyOf(char c, std::string_view chars)
+        {
+            return chars.find(c) != std::string_view::npos;
+        }
+
+        /// Element escaped at compile time
+        template <FixedString Element, FixedString SpecialChars>
+        struct Escaped
+        {
+            static constexpr std::size_t size = []
+            {
+                std::size_t n{0};
+                for (const char c : Element.view())
+                {
+                    n += isAnyOf(c, SpecialChars.view()) ? 2 : 1;
+                }
+                return n;
+            }();
+
+            static constexpr std::array<char, size> chars = []
+            {
+                std::array<char, size> escaped{};
+                std::size_t i{0};
+                for (const char c : Element.view())
+                {
+                    if (isAnyOf(c, SpecialChars.view()))
+                    {
+                        escaped[i++] = '\\';
+                    }
+                    escaped[i++] = c;
+                }
+                return escaped;
+            }();
+
+            static constexpr std::string_view value{chars.data(), size};
+        };
+
+        // https://docs.influxdata.com/influxdb/cloud/reference/syntax/line-protocol/#special-characters
+        template <FixedString Name>
+        inline constexpr std::string_view escapedMeasurement = Escaped<Name, ", ">::value;
+
+        template <FixedString Name>
+        inline constexpr std::string_view escapedKey = Escaped<Name, ",= ">::value;
+
+        template <FixedString Name, FixedString... Names>
+        constexpr std::size_t indexOf()
+        {
+            constexpr std::array<std::string_view, sizeof...(Names)> names{Names.view()...};
+            return static_cast<std::size_t>(std::distance(names.begin(), std::find(names.begin(), names.end(), Name.view())));
+        }
+
+        template <FixedString... Names>
+        constexpr bool isUnique()
+        {
+            constexpr std::array<std::string_view, sizeof...(Names)> names{Names.view()...};
+            for (std::size_t i = 0; i < names.size(); ++i)
+            {
+                if (std::find(names.begin() + static_cast<std::ptrdiff_t>(i) + 1, names.end(), names[i]) != names.end())
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    template <FixedString Measurement, class TagList, class FieldList>
+    struct TypedPoint;
+
+    /// \brief Point of a schema known at compile time
+    ///
+    /// Measurement, tag and field keys are template arguments, escaped at
+    /// compile time; the point stores only the values, in declaration order.
+    /// Serialization appends the preformatted keys and the values through a
+    /// LineWriter, without variant dispatch or per point key storage:
+    ///
+    ///     using Cpu = TypedPoint<"cpu", Tags<"host", "region">,
+    ///                            Fields<Field<"usage", double>, Field<"procs", std::int64_t>>>;
+    ///     db->write(Cpu{{"host-1", "eu"}, {0.64, 12}, std::chrono::system_clock::now()});
+    template <FixedString Measurement, FixedString... TagNames, FixedString... FieldNames, class... FieldTypes>
+    struct TypedPoint<Measurement, Tags<TagNames...>, Fields<Field<FieldNames, FieldTypes>...>>
+    {
+        static_assert(sizeof...(FieldNames) > 0, "A point requires at least one field");
+        static_assert(((TagNames.view().size() > 0) && ...) && ((FieldNames.view().size() > 0) && ...), "Keys must not be empty");
+        static_assert(internal::isUnique<TagNames...>(), "Tag keys must be unique");
+        static_assert(internal::isUnique<FieldNames...>(), "Field keys must be unique");
+
+        using TimePoint = Point::TimePoint;
+        using TagValues = std::array<std::string, sizeof...(TagNames)>;
+        using FieldValues = std::tuple<FieldTypes...>;
+
+        TypedPoint() = default;
+
+        /// Constructs point of the tag and field values, in declaration order;
+        /// without timestamp (std::nullopt) the server assigns its time on write
+        TypedPoint(TagValues tagValues, FieldValues fieldValues, std::optional<TimePoint> time = std::nullopt)
+            : tags(std::move(tagValues)), fields(std::move(fieldValues)), timestamp(time)
+        {
+        }
+
+        /// Tag value by key
+        template <FixedString Name>
+        std::string& tag()
+        {
+            return tags[tagIndex<Name>()];
+        }
+
+        template <FixedString Name>
+        const std::string& tag() const
+        {
+            return tags[tagIndex<Name>()];
+        }
+
+        /// Field value by key
+        template <FixedString Name>
+        auto& field()
+        {
+            return std::get<fieldIndex<Name>()>(fields);
+        }
+
+        template <FixedString Name>
+        const auto& field() const
+        {
+            return std::get<fieldIndex<Name>()>(fields);
+        }
+
+        /// Appends the point as line protocol; tags with empty value are
+        /// omitted, as for Point
+        /// \param writer
+        void formatTo(LineWriter& writer) const
+        {
+            writer.measurement(internal::escapedMeasurement<Measurement>);
+            formatTags(writer, std::make_index_sequence<sizeof...(TagNames)>{});
+            formatFields(writer, std::make_index_sequence<sizeof...(FieldTypes)>{});
+
+            if (timestamp)
+            {
+                writer.timestamp(*timestamp);
+            }
+        }
+
+        /// Appends the point as line protocol
+        /// \param line
+        /// \param precision
+        /// \param globalTags   escaped tags following the measurement
+        void formatTo(std::string& line, TimePrecision precision = TimePrecision::NanoSeconds, std::string_view globalTags = {}) const
+        {
+            LineWriter writer{line, precision, globalTags};
+            formatTo(writer);
+        }
+
+        /// Returns the point as line protocol
+        std::string toLineProtocol(TimePrecision precision = TimePrecision::NanoSeconds) const
+        {
+            std::string line;
+            formatTo(line, precision);
+            return line;
+        }
+
+        /// Converts to a dynamic point, eg. for aggregation or batch coalescing
+        Point toPoint() const
+        {
+            Point point{std::string{Measurement.view()}, timestamp};
+            addTags(point, std::make_index_sequence<sizeof...(TagNames)>{});
+            addFields(point, std::make_index_sequence<sizeof...(FieldTypes)>{});
+            return point;
+        }
+
+        /// Tag values, in order of the tag keys
+        TagValues tags{};
+
+        /// Field values, in order of the field keys
+        FieldValues fields{};
+
+        /// A timestamp, assigned by the server if not set
+        std::optional<TimePoint> timestamp{};
+
+    private:
+        template <FixedString Name>
+        static constexpr std::size_t tagIndex()
+        {
+            constexpr auto index = internal::indexOf<Name, TagNames...>();
+            static_assert(index < sizeof...(TagNames), "Unknown tag key");
+            return index;
+        }
+
+        template <FixedString Name>
+        static constexpr std::size_t fieldIndex()
+        {
+            constexpr auto index = internal::indexOf<Name, FieldNames...>();
+            static_assert(index < sizeof...(FieldNames), "Unknown field key");
+            return index;
+        }
+
+        template <std::size_t... Is>
+        void formatTags(LineWriter& writer, std::index_sequence<Is...>) const
+        {
+            (writer.tag(internal::escapedKey<TagNames>, tags[Is]), ...);
+        }
+
+        template <std::size_t... Is>
+        void formatFields(LineWriter& writer, std::index_sequence<Is...>) const
+        {
+            (writer.field(internal::escapedKey<FieldNames>, toLineValue(std::get<Is>(fields))), ...);
+        }
+
+        template <class T>
+        static auto toLineValue(const T& value)
+        {
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                return value;
+            }
+            else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+            {
+                return static_cast<long long int>(value);
+            }
+            else if constexpr (std::is_integral_v<T>)
+            {
+                return static_cast<unsigned long long int>(value);
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                return static_cast<double>(value);
+            }
+            else
+            {
+                static_assert(std::is_convertible_v<const T&, std::string_view>, "Field type must be arithmetic or a string");
+                return std::string_view{value};
+            }
+        }
+
+        template <std::size_t... Is>
+        void addTags(Point& point, std::index_sequence<Is...>) const
+        {
+            (point.addTag(TagNames.view(), tags[Is]), ...);
+        }
+
+        template <std::size_t... Is>
+        void addFields(Point& point, std::index_sequence<Is...>) const
+        {
+            (point.addField(FieldNames.view(), toFieldValue(std::get<Is>(fields))), ...);
+        }
+
+        template <class T>
+        static Point::FieldValue toFieldValue(const T& value)
+        {
+            if constexpr (std::is_same_v<decltype(toLineValue(value)), std::string_view>)
+            {
+                return std::string{toLineValue(value)};
+            }
+            else
+            {
+                return toLineValue(value);
+            }
+        }
+    };
+}
+
+#endif // INFLUXDATA_TYPEDPOINT_H
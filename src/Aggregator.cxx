@@ -0,0 +1,237 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InfluxDB/Aggregator.h"
+#include "InfluxDB/InfluxDBException.h"
+#include "SeriesKey.h"
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <variant>
+
+namespace influxdb
+{
+    namespace
+    {
+        template <class... Ts>
+        struct overloaded : Ts...
+        {
+            using Ts::operator()...;
+        };
+        template <class... Ts>
+        overloaded(Ts...) -> overloaded<Ts...>;
+
+        std::optional<double> toNumber(const Point::FieldValue& value)
+        {
+            return std::visit(overloaded{
+                                  [](const std::string&) -> std::optional<double>
+                                  { return std::nullopt; },
+                                  [](bool) -> std::optional<double>
+                                  { return std::nullopt; },
+                                  [](auto v) -> std::optional<double>
+                                  { return static_cast<double>(v); },
+                              },
+                              value);
+        }
+    }
+
+    std::string_view toString(Aggregation aggregation)
+    {
+        switch (aggregation)
+        {
+            case Aggregation::Sum:
+                return "sum";
+            case Aggregation::Min:
+                return "min";
+            case Aggregation::Max:
+                return "max";
+            case Aggregation::Count:
+                return "count";
+            case Aggregation::Last:
+                return "last";
+            case Aggregation::Mean:
+                return "mean";
+        }
+        return "unknown";
+    }
+
+    Aggregator::Aggregator(std::chrono::milliseconds window, std::vector<Aggregation> aggregations)
+        : window_(window), aggregations_(std::move(aggregations)), series_{}, latestWindow_{TimePoint::min()}
+    {
+        if (window_.count() <= 0)
+        {
+            throw InfluxDBException{"Aggregation window must be positive"};
+        }
+        if (aggregations_.empty())
+        {
+            throw InfluxDBException{"No aggregation given"};
+        }
+    }
+
+    std::vector<Point> Aggregator::add(Point&& point)
+    {
+        std::vector<Point> completed;
+        // Points without timestamp are aggregated by their arrival
+        const auto start = windowOf(point.hasTimestamp() ? point.getTimestamp() : std::chrono::system_clock::now());
+
+        // Windows before the latest one were completed for all series, a point of
+        // them would open a second window of the same timestamp
+        if (start < latestWindow_)
+        {
+            completed.push_back(std::move(point));
+            return completed;
+        }
+
+        // A later window completes the windows of all series, not only of this one
+        if (start > latestWindow_)
+        {
+            latestWindow_ = start;
+
+            for (auto itr = series_.begin(); itr != series_.end();)
+            {
+                if (itr->second.start < start)
+                {
+                    completed.push_back(toPoint(itr->second));
+                    itr = series_.erase(itr);
+                }
+                else
+                {
+                    ++itr;
+                }
+            }
+        }
+
+        const auto key = internal::seriesKey(point);
+        auto itr = series_.find(key);
+
+        if (itr == series_.end())
+        {
+            itr = series_.emplace(key, Window{point.getName(), point.getTagSet(), start, {}}).first;
+        }
+
+        aggregate(itr->second, point);
+        return completed;
+    }
+
+    std::vector<Point> Aggregator::flush()
+    {
+        std::vector<Point> points;
+        points.reserve(series_.size());
+
+        for (const auto& [key, window] : series_)
+        {
+            points.push_back(toPoint(window));
+        }
+        series_.clear();
+        return points;
+    }
+
+    std::size_t Aggregator::activeSeries() const
+    {
+        return series_.size();
+    }
+
+    Aggregator::TimePoint Aggregator::windowOf(TimePoint timestamp) const
+    {
+        auto offset = timestamp.time_since_epoch() % window_;
+
+        if (offset.count() < 0)
+        {
+            offset += window_;
+        }
+        return timestamp - offset;
+    }
+
+    void Aggregator::aggregate(Window& window, const Point& point) const
+    {
+        for (const auto& [name, value] : point.getFieldSet())
+        {
+            auto field = std::find_if(window.fields.begin(), window.fields.end(), [&name](const auto& f)
+                                      { return f.name == name; });
+
+            if (field == window.fields.end())
+            {
+                field = window.fields.insert(window.fields.end(), FieldState{name, true, 0, 0.0, std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest(), value});
+            }
+
+            const auto number = toNumber(value);
+            field->numeric = field->numeric && number.has_value();
+            field->last = value;
+
+            if (number)
+            {
+                ++field->count;
+                field->sum += *number;
+                field->min = std::min(field->min, *number);
+                field->max = std::max(field->max, *number);
+            }
+        }
+    }
+
+    Point Aggregator::toPoint(const Window& window) const
+    {
+        Point point{window.measurement};
+
+        for (const auto& [name, value] : window.tags)
+        {
+            point.addTag(name, value);
+        }
+
+        for (const auto& field : window.fields)
+        {
+            if (!field.numeric)
+            {
+                point.addField(field.name, field.last);
+                continue;
+            }
+
+            for (const auto aggregation : aggregations_)
+            {
+                const auto name = field.name + "_" + std::string{toString(aggregation)};
+
+                switch (aggregation)
+                {
+                    case Aggregation::Sum:
+                        point.addField(name, field.sum);
+                        break;
+                    case Aggregation::Min:
+                        point.addField(name, field.min);
+                        break;
+                    case Aggregation::Max:
+                        point.addField(name, field.max);
+                        break;
+                    case Aggregation::Count:
+                        point.addField(name, static_cast<long long int>(field.count));
+                        break;
+                    case Aggregation::Last:
+                        point.addField(name, field.last);
+                        break;
+                    case Aggregation::Mean:
+                        point.addField(name, field.sum / static_cast<double>(field.count));
+                        break;
+                }
+            }
+        }
+        point.setTimestamp(window.start);
+        return point;
+    }
+}
@@ -0,0 +1,181 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InfluxDB/ArenaPoint.h"
+#include "PointClock.h"
+#include <tuple>
+#include <type_traits>
+
+namespace influxdb
+{
+    namespace
+    {
+        template <class... Ts>
+        struct overloaded : Ts...
+        {
+            using Ts::operator()...;
+        };
+        template <class... Ts>
+        overloaded(Ts...) -> overloaded<Ts...>;
+    }
+
+    ArenaPoint::ArenaPoint(std::string_view measurement, std::pmr::memory_resource* resource)
+        : ArenaPoint(measurement, internal::currentTime(), resource)
+    {
+    }
+
+    ArenaPoint::ArenaPoint(std::string_view measurement, std::optional<TimePoint> timestamp, std::pmr::memory_resource* resource)
+        : measurement_(measurement, resource), timestamp_(timestamp), tags_(resource), fields_(resource)
+    {
+    }
+
+    ArenaPoint&& ArenaPoint::addTag(std::string_view key, std::string_view value)
+    {
+        if (!key.empty() && !value.empty())
+        {
+            tags_.emplace_back(key, value);
+        }
+        return std::move(*this);
+    }
+
+    ArenaPoint&& ArenaPoint::addField(std::string_view name, const Point::FieldValue& value)
+    {
+        if (name.empty())
+        {
+            return std::move(*this);
+        }
+
+        std::visit(overloaded{
+                       [this, name](int v)
+                       { fields_.emplace_back(name, FieldValue{static_cast<long long int>(v)}); },
+                       [this, name](unsigned int v)
+                       { fields_.emplace_back(name, FieldValue{static_cast<unsigned long long int>(v)}); },
+                       [this, name](const std::string& v)
+                       { addField(name, std::string_view{v}); },
+                       [this, name](const auto& v)
+                       { fields_.emplace_back(name, FieldValue{v}); },
+                   },
+                   value);
+        return std::move(*this);
+    }
+
+    ArenaPoint&& ArenaPoint::addField(std::string_view name, std::string_view value)
+    {
+        if (!name.empty())
+        {
+            fields_.emplace_back(std::piecewise_construct, std::forward_as_tuple(name),
+                                 std::forward_as_tuple(std::in_place_type<std::pmr::string>, value, getResource()));
+        }
+        return std::move(*this);
+    }
+
+    ArenaPoint&& ArenaPoint::setTimestamp(TimePoint timestamp)
+    {
+        timestamp_ = timestamp;
+        return std::move(*this);
+    }
+
+    std::string_view ArenaPoint::getName() const
+    {
+        return measurement_;
+    }
+
+    ArenaPoint::TimePoint ArenaPoint::getTimestamp() const
+    {
+        return timestamp_.value_or(TimePoint{});
+    }
+
+    bool ArenaPoint::hasTimestamp() const
+    {
+        return timestamp_.has_value();
+    }
+
+    const ArenaPoint::TagSet& ArenaPoint::getTagSet() const
+    {
+        return tags_;
+    }
+
+    const ArenaPoint::FieldSet& ArenaPoint::getFieldSet() const
+    {
+        return fields_;
+    }
+
+    std::pmr::memory_resource* ArenaPoint::getResource() const
+    {
+        return tags_.get_allocator().resource();
+    }
+
+    void ArenaPoint::formatTo(LineWriter& writer) const
+    {
+        writer.measurement(LineWriter::Unescaped{measurement_});
+
+        for (const auto& [key, value] : tags_)
+        {
+            writer.tag(LineWriter::Unescaped{key}, value);
+        }
+        for (const auto& [key, value] : fields_)
+        {
+            std::visit([&writer, k = LineWriter::Unescaped{key}](const auto& v)
+                       {
+                           if constexpr (std::is_same_v<std::decay_t<decltype(v)>, std::pmr::string>)
+                           {
+                               writer.field(k, std::string_view{v});
+                           }
+                           else
+                           {
+                               writer.field(k, v);
+                           }
+                       },
+                       value);
+        }
+        if (timestamp_)
+        {
+            writer.timestamp(*timestamp_);
+        }
+    }
+
+    Point ArenaPoint::toPoint() const
+    {
+        Point point{std::string{measurement_}, timestamp_};
+
+        for (const auto& [key, value] : tags_)
+        {
+            point.addTag(key, value);
+        }
+        for (const auto& [key, value] : fields_)
+        {
+            std::visit([&point, &key](const auto& v)
+                       {
+                           if constexpr (std::is_same_v<std::decay_t<decltype(v)>, std::pmr::string>)
+                           {
+                               point.addField(key, std::string{v});
+                           }
+                           else
+                           {
+                               point.addField(key, v);
+                           }
+                       },
+                       value);
+        }
+        return point;
+    }
+}
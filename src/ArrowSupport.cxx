@@ -0,0 +1,291 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InfluxDB/ColumnarResult.h"
+#include <arrow/api.h>
+#include <arrow/io/api.h>
+#include <arrow/ipc/api.h>
+
+namespace influxdb
+{
+    namespace
+    {
+        void checkStatus(const ::arrow::Status& status)
+        {
+            if (!status.ok())
+            {
+                throw InfluxDBException{"Arrow decoding failed: " + status.ToString()};
+            }
+        }
+
+        template <class T>
+        T unwrap(::arrow::Result<T>&& result)
+        {
+            checkStatus(result.status());
+            return std::move(result).ValueUnsafe();
+        }
+
+        // Rows of a column array; dictionary encoded arrays are resolved to their dictionary
+        class Rows
+        {
+        public:
+            explicit Rows(const ::arrow::Array& array)
+                : array_(array),
+                  dictionary_(array.type_id() == ::arrow::Type::DICTIONARY ? &static_cast<const ::arrow::DictionaryArray&>(array) : nullptr)
+            {
+            }
+
+            const ::arrow::Array& values() const
+            {
+                return dictionary_ != nullptr ? *dictionary_->dictionary() : array_;
+            }
+
+            std::int64_t size() const
+            {
+                return array_.length();
+            }
+
+            std::int64_t index(std::int64_t row) const
+            {
+                return dictionary_ != nullptr ? dictionary_->GetValueIndex(row) : row;
+            }
+
+            bool isNull(std::int64_t row) const
+            {
+                return array_.IsNull(row) || (dictionary_ != nullptr && dictionary_->dictionary()->IsNull(index(row)));
+            }
+
+            bool mayHaveNulls() const
+            {
+                return array_.null_count() > 0 || (dictionary_ != nullptr && dictionary_->dictionary()->null_count() > 0);
+            }
+
+        private:
+            const ::arrow::Array& array_;
+            const ::arrow::DictionaryArray* dictionary_;
+        };
+
+        template <class ArrayType, class T, class Convert>
+        void appendRows(const Rows& rows, std::vector<T>& out, Convert convert)
+        {
+            const auto& values = static_cast<const ArrayType&>(rows.values());
+            out.reserve(out.size() + static_cast<std::size_t>(rows.size()));
+
+            for (std::int64_t row = 0; row < rows.size(); ++row)
+            {
+                if (rows.isNull(row))
+                {
+                    out.emplace_back();
+                }
+                else
+                {
+                    out.push_back(convert(values, rows.index(row)));
+                }
+            }
+        }
+
+        template <class ArrayType, class T>
+        void appendNumbers(const Rows& rows, Column::Values& out)
+        {
+            appendRows<ArrayType>(rows, std::get<std::vector<T>>(out), [](const ArrayType& values, std::int64_t index)
+                                  { return static_cast<T>(values.Value(index)); });
+        }
+
+        template <class ArrayType>
+        void appendStrings(const Rows& rows, Column::Values& out)
+        {
+            appendRows<ArrayType>(rows, std::get<std::vector<std::string>>(out), [](const ArrayType& values, std::int64_t index)
+                                  { return std::string{values.GetView(index)}; });
+        }
+
+        void appendTimeStamps(const Rows& rows, Column::Values& out)
+        {
+            const auto unit = static_cast<const ::arrow::TimestampType&>(*rows.values().type()).unit();
+            const std::int64_t factor = [unit]
+            {
+                switch (unit)
+                {
+                    case ::arrow::TimeUnit::SECOND:
+                        return 1'000'000'000;
+                    case ::arrow::TimeUnit::MILLI:
+                        return 1'000'000;
+                    case ::arrow::TimeUnit::MICRO:
+                        return 1'000;
+                    default:
+                        return 1;
+                }
+            }();
+
+            appendRows<::arrow::TimestampArray>(rows, std::get<std::vector<Column::TimeStamp>>(out), [factor](const ::arrow::TimestampArray& values, std::int64_t index)
+                                                { return Column::TimeStamp{std::chrono::nanoseconds{values.Value(index) * factor}}; });
+        }
+
+        Column::Values emptyValues(const ::arrow::DataType& type)
+        {
+            switch (type.id())
+            {
+                case ::arrow::Type::INT8:
+                case ::arrow::Type::INT16:
+                case ::arrow::Type::INT32:
+                case ::arrow::Type::INT64:
+                    return std::vector<std::int64_t>{};
+                case ::arrow::Type::UINT8:
+                case ::arrow::Type::UINT16:
+                case ::arrow::Type::UINT32:
+                case ::arrow::Type::UINT64:
+                    return std::vector<std::uint64_t>{};
+                case ::arrow::Type::FLOAT:
+                case ::arrow::Type::DOUBLE:
+                    return std::vector<double>{};
+                case ::arrow::Type::BOOL:
+                    return std::vector<bool>{};
+                case ::arrow::Type::STRING:
+                case ::arrow::Type::LARGE_STRING:
+                    return std::vector<std::string>{};
+                case ::arrow::Type::TIMESTAMP:
+                    return std::vector<Column::TimeStamp>{};
+                case ::arrow::Type::DICTIONARY:
+                    return emptyValues(*static_cast<const ::arrow::DictionaryType&>(type).value_type());
+                default:
+                    throw InfluxDBException{"Unsupported Arrow type: " + type.ToString()};
+            }
+        }
+
+        void appendArray(const ::arrow::Array& array, Column& column)
+        {
+            const Rows rows{array};
+            const auto rowsBefore = column.size();
+
+            switch (rows.values().type_id())
+            {
+                case ::arrow::Type::INT8:
+                    appendNumbers<::arrow::Int8Array, std::int64_t>(rows, column.values);
+                    break;
+                case ::arrow::Type::INT16:
+                    appendNumbers<::arrow::Int16Array, std::int64_t>(rows, column.values);
+                    break;
+                case ::arrow::Type::INT32:
+                    appendNumbers<::arrow::Int32Array, std::int64_t>(rows, column.values);
+                    break;
+                case ::arrow::Type::INT64:
+                    appendNumbers<::arrow::Int64Array, std::int64_t>(rows, column.values);
+                    break;
+                case ::arrow::Type::UINT8:
+                    appendNumbers<::arrow::UInt8Array, std::uint64_t>(rows, column.values);
+                    break;
+                case ::arrow::Type::UINT16:
+                    appendNumbers<::arrow::UInt16Array, std::uint64_t>(rows, column.values);
+                    break;
+                case ::arrow::Type::UINT32:
+                    appendNumbers<::arrow::UInt32Array, std::uint64_t>(rows, column.values);
+                    break;
+                case ::arrow::Type::UINT64:
+                    appendNumbers<::arrow::UInt64Array, std::uint64_t>(rows, column.values);
+                    break;
+                case ::arrow::Type::FLOAT:
+                    appendNumbers<::arrow::FloatArray, double>(rows, column.values);
+                    break;
+                case ::arrow::Type::DOUBLE:
+                    appendNumbers<::arrow::DoubleArray, double>(rows, column.values);
+                    break;
+                case ::arrow::Type::BOOL:
+                    appendNumbers<::arrow::BooleanArray, bool>(rows, column.values);
+                    break;
+                case ::arrow::Type::STRING:
+                    appendStrings<::arrow::StringArray>(rows, column.values);
+                    break;
+                case ::arrow::Type::LARGE_STRING:
+                    appendStrings<::arrow::LargeStringArray>(rows, column.values);
+                    break;
+                case ::arrow::Type::TIMESTAMP:
+                    appendTimeStamps(rows, column.values);
+                    break;
+                default:
+                    throw InfluxDBException{"Unsupported Arrow type: " + array.type()->ToString()};
+            }
+
+            if (rows.mayHaveNulls() || !column.validity.empty())
+            {
+                column.validity.resize(rowsBefore, true); // Rows before the first null are valid
+                for (std::int64_t row = 0; row < rows.size(); ++row)
+                {
+                    column.validity.push_back(!rows.isNull(row));
+                }
+            }
+        }
+
+        std::vector<Column> createColumns(const ::arrow::Schema& schema)
+        {
+            std::vector<Column> columns;
+            columns.reserve(static_cast<std::size_t>(schema.num_fields()));
+
+            for (const auto& field : schema.fields())
+            {
+                columns.push_back(Column{field->name(), emptyValues(*field->type()), {}});
+            }
+            return columns;
+        }
+
+        void appendBatch(const ::arrow::RecordBatch& batch, std::vector<Column>& columns)
+        {
+            for (int i = 0; i < batch.num_columns(); ++i)
+            {
+                appendArray(*batch.column(i), columns[static_cast<std::size_t>(i)]);
+            }
+        }
+    }
+
+    ColumnarResult readArrowStream(std::string_view data)
+    {
+        const auto buffer = std::make_shared<::arrow::Buffer>(reinterpret_cast<const std::uint8_t*>(data.data()), static_cast<std::int64_t>(data.size()));
+        ::arrow::io::BufferReader input{buffer};
+        const auto reader = unwrap(::arrow::ipc::RecordBatchStreamReader::Open(&input));
+
+        auto columns = createColumns(*reader->schema());
+
+        for (std::shared_ptr<::arrow::RecordBatch> batch;;)
+        {
+            checkStatus(reader->ReadNext(&batch));
+
+            if (batch == nullptr)
+            {
+                break;
+            }
+            appendBatch(*batch, columns);
+        }
+        return ColumnarResult{std::move(columns)};
+    }
+
+    ColumnarResult readArrowFile(const std::string& path)
+    {
+        const auto file = unwrap(::arrow::io::ReadableFile::Open(path));
+        const auto reader = unwrap(::arrow::ipc::RecordBatchFileReader::Open(file));
+
+        auto columns = createColumns(*reader->schema());
+
+        for (int i = 0; i < reader->num_record_batches(); ++i)
+        {
+            appendBatch(*unwrap(reader->ReadRecordBatch(i)), columns);
+        }
+        return ColumnarResult{std::move(columns)};
+    }
+}
@@ -22,10 +22,15 @@
 // SOFTWARE.
 
 #include "BoostSupport.h"
+#include "InfluxDB/InfluxDBException.h"
 #include "UDP.h"
 #include "TCP.h"
 #include "UnixSocket.h"
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <charconv>
+#include <iterator>
 #include <boost/lexical_cast.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/json_parser.hpp>
@@ -35,6 +40,24 @@ namespace influxdb::internal
 {
     namespace
     {
+        // A response which isn't JSON (eg. an error page of a proxy) is a failed query
+        boost::property_tree::ptree parseResponse(std::string_view response)
+        {
+            std::stringstream responseString;
+            responseString << response;
+            boost::property_tree::ptree pt;
+
+            try
+            {
+                boost::property_tree::read_json(responseString, pt);
+            }
+            catch (const boost::property_tree::json_parser_error& e)
+            {
+                throw InfluxDBException{"Invalid query response: " + e.message()};
+            }
+            return pt;
+        }
+
         std::chrono::system_clock::time_point parseTimeStamp(const std::string& value)
         {
             std::istringstream timeString{value};
@@ -42,65 +65,191 @@ namespace influxdb::internal
             timeString >> date::parse("%FT%T%Z", timeStamp);
             return timeStamp;
         }
-    }
 
-    std::vector<Point> queryImpl(Transport* transport, const std::string& query)
-    {
-        const auto response = transport->query(query);
-        std::stringstream responseString;
-        responseString << response;
-        std::vector<Point> points;
-        boost::property_tree::ptree pt;
-        boost::property_tree::read_json(responseString, pt);
+        template <class TimeUnit>
+        std::chrono::system_clock::time_point fromEpoch(long long int value)
+        {
+            return std::chrono::system_clock::time_point{std::chrono::duration_cast<std::chrono::system_clock::duration>(TimeUnit{value})};
+        }
 
-        for (const auto& result : pt.get_child("results"))
+        std::chrono::system_clock::time_point parseEpochTimeStamp(TimePrecision epoch, const std::string& value)
         {
-            if (const auto isResultEmpty = result.second.find("series"); isResultEmpty == result.second.not_found())
+            long long int count{0};
+            if (const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), count); ec != std::errc{} || ptr != value.data() + value.size())
             {
-                return {};
+                throw InfluxDBException{"Invalid epoch timestamp: '" + value + "'"};
             }
-            for (const auto& series : result.second.get_child("series"))
+
+            switch (epoch)
             {
-                for (const auto& values : series.second.get_child("values"))
-                {
-                    Point point{series.second.get<std::string>("name", "")};
+                case TimePrecision::Hours:
+                    return fromEpoch<std::chrono::hours>(count);
+                case TimePrecision::Minutes:
+                    return fromEpoch<std::chrono::minutes>(count);
+                case TimePrecision::Seconds:
+                    return fromEpoch<std::chrono::seconds>(count);
+                case TimePrecision::MilliSeconds:
+                    return fromEpoch<std::chrono::milliseconds>(count);
+                case TimePrecision::MicroSeconds:
+                    return fromEpoch<std::chrono::microseconds>(count);
+                case TimePrecision::NanoSeconds:
+                default:
+                    return fromEpoch<std::chrono::nanoseconds>(count);
+            }
+        }
+
+        template <class Callback>
+        void decodeSeries(const boost::property_tree::ptree& series, std::optional<TimePrecision> epoch, Callback&& onPoint)
+        {
+            const auto& columns = series.get_child("columns");
+            const auto tags = series.get_child_optional("tags");
+
+            for (const auto& values : series.get_child("values"))
+            {
+                Point point{series.get<std::string>("name", "")};
 
-                    if (const auto tags = series.second.get_child_optional("tags"); tags)
+                if (tags)
+                {
+                    for (const auto& tag : tags.get())
+                    {
+                        point.addTag(tag.first, tag.second.data());
+                    }
+                }
+                auto iColumns = columns.begin();
+                auto iValues = values.second.begin();
+                for (; iColumns != columns.end() && iValues != values.second.end(); ++iColumns, ++iValues)
+                {
+                    const auto value = iValues->second.get_value<std::string>();
+                    const auto column = iColumns->second.get_value<std::string>();
+                    if (column == "time")
                     {
-                        for (const auto& tag : tags.get())
-                        {
-                            point.addTag(tag.first, tag.second.data());
-                        }
+                        point.setTimestamp(epoch ? parseEpochTimeStamp(*epoch, value) : parseTimeStamp(value));
+                        continue;
                     }
-                    const auto columns = series.second.get_child("columns");
-                    auto iColumns = columns.begin();
-                    auto iValues = values.second.begin();
-                    for (; iColumns != columns.end() && iValues != values.second.end(); ++iColumns, ++iValues)
+                    // cast all values to double, if strings add to tags
+                    try
                     {
-                        const auto value = iValues->second.get_value<std::string>();
-                        const auto column = iColumns->second.get_value<std::string>();
-                        if (column == "time")
-                        {
-                            point.setTimestamp(parseTimeStamp(value));
-                            continue;
-                        }
-                        // cast all values to double, if strings add to tags
-                        try
-                        {
-                            point.addField(column, boost::lexical_cast<double>(value));
-                        }
-                        catch (...)
-                        {
-                            point.addTag(column, value);
-                        }
+                        point.addField(column, boost::lexical_cast<double>(value));
+                    }
+                    catch (...)
+                    {
+                        point.addTag(column, value);
                     }
-                    points.push_back(std::move(point));
                 }
+                onPoint(std::move(point));
             }
         }
+    }
+
+    std::vector<std::vector<Point>> queryStatementsImpl(Transport* transport, const std::string& query, std::optional<TimePrecision> epoch, WorkerPool* decodePool)
+    {
+        const auto pt = parseResponse(transport->query(query));
+
+        if (const auto error = pt.get_optional<std::string>("error"); error)
+        {
+            throw InfluxDBException{"Query failed: " + *error};
+        }
+
+        // Statements without series (eg. no matching data) are kept as empty result sets
+        std::vector<std::pair<std::size_t, const boost::property_tree::ptree*>> seriesList;
+        std::size_t statementCount{0};
+        for (const auto& result : pt.get_child("results"))
+        {
+            if (const auto error = result.second.get_optional<std::string>("error"); error)
+            {
+                throw InfluxDBException{"Query failed: " + *error};
+            }
+            if (const auto series = result.second.get_child_optional("series"); series)
+            {
+                for (const auto& s : series.get())
+                {
+                    seriesList.emplace_back(statementCount, &s.second);
+                }
+            }
+            ++statementCount;
+        }
+
+        std::vector<std::vector<Point>> statements(statementCount);
+        if (decodePool == nullptr || seriesList.size() <= 1)
+        {
+            for (const auto& [statement, series] : seriesList)
+            {
+                decodeSeries(*series, epoch, [&points = statements[statement]](Point&& point)
+                             { points.push_back(std::move(point)); });
+            }
+            return statements;
+        }
+
+        // Series are independent of each other; workers pick the next pending
+        // one so uneven series sizes are balanced, the output order is kept
+        std::vector<std::vector<Point>> decoded(seriesList.size());
+        std::atomic<std::size_t> nextSeries{0};
+        const auto worker = [&seriesList, &decoded, &nextSeries, epoch]
+        {
+            for (auto i = nextSeries++; i < seriesList.size(); i = nextSeries++)
+            {
+                decodeSeries(*seriesList[i].second, epoch, [&decodedSeries = decoded[i]](Point&& point)
+                             { decodedSeries.push_back(std::move(point)); });
+            }
+        };
+
+        decodePool->run(seriesList.size(), worker);
+
+        for (std::size_t i = 0; i < decoded.size(); ++i)
+        {
+            auto& points = statements[seriesList[i].first];
+            std::move(decoded[i].begin(), decoded[i].end(), std::back_inserter(points));
+        }
+        return statements;
+    }
+
+    std::vector<Point> queryImpl(Transport* transport, const std::string& query, std::optional<TimePrecision> epoch, WorkerPool* decodePool)
+    {
+        auto statements = queryStatementsImpl(transport, query, epoch, decodePool);
+
+        if (statements.size() == 1)
+        {
+            return std::move(statements.front());
+        }
+
+        std::vector<Point> points;
+        for (auto& statement : statements)
+        {
+            std::move(statement.begin(), statement.end(), std::back_inserter(points));
+        }
         return points;
     }
 
+    void queryStreamImpl(Transport* transport, const std::string& query, std::size_t chunkSize, std::optional<TimePrecision> epoch, const std::function<void(Point&&)>& onPoint)
+    {
+        const auto decodeChunk = [epoch, &onPoint](std::string_view chunk)
+        {
+            const auto pt = parseResponse(chunk);
+
+            if (const auto error = pt.get_optional<std::string>("error"); error)
+            {
+                throw InfluxDBException{"Query failed: " + *error};
+            }
+
+            for (const auto& result : pt.get_child("results"))
+            {
+                if (const auto error = result.second.get_optional<std::string>("error"); error)
+                {
+                    throw InfluxDBException{"Query failed: " + *error};
+                }
+                if (const auto seriesList = result.second.get_child_optional("series"); seriesList)
+                {
+                    for (const auto& series : seriesList.get())
+                    {
+                        decodeSeries(series.second, epoch, onPoint);
+                    }
+                }
+            }
+        };
+
+        transport->queryChunked(query, chunkSize, decodeChunk);
+    }
+
     std::unique_ptr<Transport> withUdpTransport(const http::url& uri)
     {
         return std::make_unique<transports::UDP>(uri.host, uri.port);
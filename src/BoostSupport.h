@@ -25,14 +25,20 @@
 
 #include "InfluxDB/Transport.h"
 #include "InfluxDB/Point.h"
+#include "InfluxDB/TimePrecision.h"
 #include "UriParser.h"
+#include "WorkerPool.h"
+#include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
 namespace influxdb::internal
 {
-    std::vector<Point> queryImpl(Transport* transport, const std::string& query);
+    std::vector<std::vector<Point>> queryStatementsImpl(Transport* transport, const std::string& query, std::optional<TimePrecision> epoch = std::nullopt, WorkerPool* decodePool = nullptr);
+    std::vector<Point> queryImpl(Transport* transport, const std::string& query, std::optional<TimePrecision> epoch = std::nullopt, WorkerPool* decodePool = nullptr);
+    void queryStreamImpl(Transport* transport, const std::string& query, std::size_t chunkSize, std::optional<TimePrecision> epoch, const std::function<void(Point&&)>& onPoint);
 
     std::unique_ptr<Transport> withUdpTransport(const http::url& uri);
     std::unique_ptr<Transport> withTcpTransport(const http::url& uri);
@@ -0,0 +1,68 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InfluxDB/CoarseClock.h"
+#include "InfluxDB/InfluxDBException.h"
+
+namespace influxdb
+{
+    CoarseClock::CoarseClock(std::chrono::microseconds granularity)
+        : granularity_(granularity), now_{std::chrono::system_clock::now().time_since_epoch().count()}, mutex_{}, condition_{}, stop_{false}, thread_{}
+    {
+        if (granularity_.count() <= 0)
+        {
+            throw InfluxDBException{"Clock granularity must be positive"};
+        }
+        thread_ = std::thread{&CoarseClock::update, this};
+    }
+
+    CoarseClock::~CoarseClock()
+    {
+        {
+            std::lock_guard lock{mutex_};
+            stop_ = true;
+        }
+        condition_.notify_all();
+        thread_.join();
+    }
+
+    CoarseClock::TimePoint CoarseClock::now() const noexcept
+    {
+        return TimePoint{std::chrono::system_clock::duration{now_.load(std::memory_order_relaxed)}};
+    }
+
+    std::chrono::microseconds CoarseClock::granularity() const noexcept
+    {
+        return granularity_;
+    }
+
+    void CoarseClock::update()
+    {
+        std::unique_lock lock{mutex_};
+
+        while (!condition_.wait_for(lock, granularity_, [this]
+                                    { return stop_; }))
+        {
+            now_.store(std::chrono::system_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+        }
+    }
+}
@@ -0,0 +1,73 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InfluxDB/ColumnarResult.h"
+#include <algorithm>
+
+namespace influxdb
+{
+    std::size_t Column::size() const
+    {
+        return std::visit([](const auto& v)
+                          { return v.size(); },
+                          values);
+    }
+
+    bool Column::isNull(std::size_t row) const
+    {
+        return !validity.empty() && !validity.at(row);
+    }
+
+    ColumnarResult::ColumnarResult(std::vector<Column> columns)
+        : columns_(std::move(columns))
+    {
+        const auto rowCount = rows();
+
+        if (std::any_of(columns_.cbegin(), columns_.cend(), [rowCount](const auto& c)
+                        { return c.size() != rowCount || (!c.validity.empty() && c.validity.size() != rowCount); }))
+        {
+            throw InfluxDBException{"Columns of different length"};
+        }
+    }
+
+    std::size_t ColumnarResult::rows() const
+    {
+        return columns_.empty() ? 0 : columns_.front().size();
+    }
+
+    const std::vector<Column>& ColumnarResult::columns() const
+    {
+        return columns_;
+    }
+
+    const Column& ColumnarResult::column(std::string_view name) const
+    {
+        const auto itr = std::find_if(columns_.cbegin(), columns_.cend(), [name](const auto& c)
+                                      { return c.name == name; });
+
+        if (itr == columns_.cend())
+        {
+            throw InfluxDBException{"No column '" + std::string{name} + "'"};
+        }
+        return *itr;
+    }
+}
@@ -0,0 +1,301 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InfluxDB/Failover.h"
+#include "InfluxDB/InfluxDBFactory.h"
+#include <algorithm>
+
+namespace influxdb::transports
+{
+    namespace
+    {
+        std::vector<FailoverEndpoint> withoutHealthCheck(std::vector<std::unique_ptr<Transport>> transports)
+        {
+            std::vector<FailoverEndpoint> endpoints;
+            endpoints.reserve(transports.size());
+
+            for (auto& transport : transports)
+            {
+                endpoints.push_back(FailoverEndpoint{std::move(transport)});
+            }
+            return endpoints;
+        }
+
+        std::vector<FailoverEndpoint> withHealthCheck(const std::vector<std::string>& urls)
+        {
+            std::vector<FailoverEndpoint> endpoints;
+            endpoints.reserve(urls.size());
+
+            for (const auto& url : urls)
+            {
+                endpoints.push_back(FailoverEndpoint{InfluxDBFactory::GetTransport(url), InfluxDBFactory::GetTransport(url)});
+            }
+            return endpoints;
+        }
+    }
+
+    Failover::Failover(std::vector<std::unique_ptr<Transport>> endpoints, FailoverOptions options)
+        : Failover(withoutHealthCheck(std::move(endpoints)), options)
+    {
+    }
+
+    Failover::Failover(const std::vector<std::string>& urls, FailoverOptions options)
+        : Failover(withHealthCheck(urls), options)
+    {
+    }
+
+    Failover::Failover(std::vector<FailoverEndpoint> endpoints, FailoverOptions options)
+        : endpoints_{}, options_(options), errorMutex_{}, lastError_{}, mutex_{}, condition_{}, stop_{false}, healthCheckThread_{}
+    {
+        if (endpoints.empty())
+        {
+            throw InfluxDBException{"Failover requires at least one endpoint"};
+        }
+        if (std::any_of(endpoints.cbegin(), endpoints.cend(), [](const auto& endpoint)
+                        { return endpoint.transport == nullptr; }))
+        {
+            throw InfluxDBException{"Endpoint must not be nullptr"};
+        }
+
+        endpoints_.reserve(endpoints.size());
+        for (auto& e : endpoints)
+        {
+            if (e.healthCheck != nullptr)
+            {
+                e.healthCheck->setTimeout(options_.healthCheckTimeout);
+            }
+
+            auto endpoint = std::make_unique<Endpoint>();
+            endpoint->transport = std::move(e.transport);
+            endpoint->healthCheck = std::move(e.healthCheck);
+            endpoints_.push_back(std::move(endpoint));
+        }
+
+        healthCheckThread_ = std::thread{&Failover::checkHealth, this};
+    }
+
+    Failover::~Failover()
+    {
+        {
+            std::lock_guard lock{mutex_};
+            stop_ = true;
+        }
+        condition_.notify_all();
+        healthCheckThread_.join();
+    }
+
+    template <class Function>
+    auto Failover::route(Function function)
+    {
+        std::optional<std::string> error;
+
+        for (std::size_t i = 0; i < endpoints_.size(); ++i)
+        {
+            auto& endpoint = endpoints_[i];
+
+            if (!endpoint->healthy)
+            {
+                continue;
+            }
+
+            std::lock_guard transportLock{endpoint->transportMutex};
+
+            // May have been checked while waiting for the lock
+            if (!endpoint->healthy)
+            {
+                continue;
+            }
+
+            try
+            {
+                return function(*endpoint->transport);
+            }
+            catch (const ConnectionException& e)
+            {
+                // Restored by the health checks once reachable again
+                endpoint->healthy = false;
+                error = "endpoint " + std::to_string(i) + ": " + e.what();
+                setLastError(*error);
+            }
+        }
+
+        // Error of this request if an endpoint failed, otherwise of the health checks
+        if (!error)
+        {
+            std::lock_guard lock{errorMutex_};
+            error = lastError_;
+        }
+        throw InfluxDBException{"No healthy endpoint" + (error->empty() ? "" : " (last error: " + *error + ")")};
+    }
+
+    template <class Function>
+    void Failover::forEachEndpoint(Function function)
+    {
+        for (auto& endpoint : endpoints_)
+        {
+            std::lock_guard transportLock{endpoint->transportMutex};
+            function(*endpoint->transport);
+        }
+    }
+
+    void Failover::send(std::string&& message)
+    {
+        // Copied per attempt, the message is needed again if the endpoint fails
+        route([&message](Transport& transport)
+              { transport.send(std::string{message}); });
+    }
+
+    std::string Failover::query(const std::string& query)
+    {
+        return route([&query](Transport& transport)
+                     { return transport.query(query); });
+    }
+
+    void Failover::queryChunked(const std::string& query, std::size_t chunkSize, const std::function<void(std::string_view)>& onChunk)
+    {
+        route([&query, chunkSize, &onChunk](Transport& transport)
+              { transport.queryChunked(query, chunkSize, onChunk); });
+    }
+
+    std::string Failover::queryArrow(const std::string& query)
+    {
+        return route([&query](Transport& transport)
+                     { return transport.queryArrow(query); });
+    }
+
+    std::string Failover::execute(const std::string& cmd)
+    {
+        return route([&cmd](Transport& transport)
+                     { return transport.execute(cmd); });
+    }
+
+    void Failover::createDatabase()
+    {
+        forEachEndpoint([](Transport& transport)
+                        { transport.createDatabase(); });
+    }
+
+    void Failover::setProxy(const Proxy& proxy)
+    {
+        forEachEndpoint([&proxy](Transport& transport)
+                        { transport.setProxy(proxy); });
+    }
+
+    void Failover::setTimePrecision(TimePrecision precision)
+    {
+        forEachEndpoint([precision](Transport& transport)
+                        { transport.setTimePrecision(precision); });
+    }
+
+    void Failover::setQueryEpoch(TimePrecision epoch)
+    {
+        forEachEndpoint([epoch](Transport& transport)
+                        { transport.setQueryEpoch(epoch); });
+    }
+
+    void Failover::setTimeout(std::chrono::milliseconds timeout)
+    {
+        forEachEndpoint([timeout](Transport& transport)
+                        { transport.setTimeout(timeout); });
+    }
+
+    bool Failover::ping()
+    {
+        return activeEndpoint().has_value();
+    }
+
+    std::optional<std::size_t> Failover::activeEndpoint() const
+    {
+        const auto endpoint = std::find_if(endpoints_.cbegin(), endpoints_.cend(), [](const auto& e)
+                                           { return e->healthy.load(); });
+
+        if (endpoint == endpoints_.cend())
+        {
+            return std::nullopt;
+        }
+        return static_cast<std::size_t>(std::distance(endpoints_.cbegin(), endpoint));
+    }
+
+    std::optional<std::string> Failover::reachabilityError(Transport& transport)
+    {
+        try
+        {
+            if (transport.ping())
+            {
+                return std::nullopt;
+            }
+            return "Ping failed";
+        }
+        catch (const InfluxDBException& e)
+        {
+            return e.what();
+        }
+    }
+
+    std::optional<std::string> Failover::healthError(Endpoint& endpoint)
+    {
+        if (endpoint.healthCheck != nullptr)
+        {
+            return reachabilityError(*endpoint.healthCheck);
+        }
+
+        // Requests skip an unhealthy endpoint, so checking it never delays them;
+        // a healthy one is marked unhealthy by a failing request
+        if (endpoint.healthy)
+        {
+            return std::nullopt;
+        }
+        std::lock_guard transportLock{endpoint.transportMutex};
+        return reachabilityError(*endpoint.transport);
+    }
+
+    void Failover::checkHealth()
+    {
+        std::unique_lock lock{mutex_};
+
+        while (!stop_)
+        {
+            lock.unlock();
+
+            for (std::size_t i = 0; i < endpoints_.size(); ++i)
+            {
+                const auto error = healthError(*endpoints_[i]);
+                endpoints_[i]->healthy = !error.has_value();
+
+                if (error)
+                {
+                    setLastError("endpoint " + std::to_string(i) + ": " + *error);
+                }
+            }
+
+            lock.lock();
+            condition_.wait_for(lock, options_.healthCheckInterval, [this]
+                                { return stop_; });
+        }
+    }
+
+    void Failover::setLastError(const std::string& error)
+    {
+        std::lock_guard lock{errorMutex_};
+        lastError_ = error;
+    }
+}
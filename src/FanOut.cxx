@@ -0,0 +1,260 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InfluxDB/FanOut.h"
+#include "InfluxDB/InfluxDBException.h"
+#include <algorithm>
+
+namespace influxdb::transports
+{
+    namespace
+    {
+        // Failures which may succeed if repeated; others (eg. a parse error) would fail again
+        bool isTransient(const InfluxDBException& error)
+        {
+            if (dynamic_cast<const ConnectionException*>(&error) != nullptr)
+            {
+                return true;
+            }
+            const auto* failed = dynamic_cast<const RequestFailedException*>(&error);
+            return failed != nullptr && RetryPolicy::isRetryableStatus(failed->status());
+        }
+    }
+
+    FanOut::FanOut(std::vector<std::unique_ptr<Transport>> replicas, FanOutOptions options)
+        : replicas_{}, options_(options)
+    {
+        if (replicas.empty())
+        {
+            throw InfluxDBException{"Fan-out requires at least one replica"};
+        }
+        if (std::any_of(replicas.cbegin(), replicas.cend(), [](const auto& replica)
+                        { return replica == nullptr; }))
+        {
+            throw InfluxDBException{"Replica must not be nullptr"};
+        }
+
+        replicas_.reserve(replicas.size());
+        for (auto& transport : replicas)
+        {
+            auto replica = std::make_unique<Replica>();
+            replica->transport = std::move(transport);
+            replicas_.push_back(std::move(replica));
+        }
+
+        for (auto& replica : replicas_)
+        {
+            replica->worker = std::thread{&FanOut::deliver, this, std::ref(*replica)};
+        }
+    }
+
+    FanOut::~FanOut()
+    {
+        for (auto& replica : replicas_)
+        {
+            {
+                std::lock_guard lock{replica->mutex};
+                replica->stop = true;
+            }
+            replica->condition.notify_all();
+        }
+
+        for (auto& replica : replicas_)
+        {
+            replica->worker.join();
+        }
+    }
+
+    void FanOut::send(std::string&& message)
+    {
+        // Shared by all queues instead of copied per replica
+        const auto shared = std::make_shared<const std::string>(std::move(message));
+
+        for (auto& replica : replicas_)
+        {
+            {
+                std::lock_guard lock{replica->mutex};
+                if (replica->queue.size() >= std::max<std::size_t>(options_.maxQueuedMessages, 1))
+                {
+                    replica->queue.pop_front();
+                    ++replica->dropped;
+                }
+                replica->queue.push_back(shared);
+            }
+            replica->condition.notify_all();
+        }
+    }
+
+    std::string FanOut::query(const std::string& query)
+    {
+        auto& primary = *replicas_.front();
+        std::lock_guard transportLock{primary.transportMutex};
+        return primary.transport->query(query);
+    }
+
+    void FanOut::queryChunked(const std::string& query, std::size_t chunkSize, const std::function<void(std::string_view)>& onChunk)
+    {
+        auto& primary = *replicas_.front();
+        std::lock_guard transportLock{primary.transportMutex};
+        primary.transport->queryChunked(query, chunkSize, onChunk);
+    }
+
+    std::string FanOut::queryArrow(const std::string& query)
+    {
+        auto& primary = *replicas_.front();
+        std::lock_guard transportLock{primary.transportMutex};
+        return primary.transport->queryArrow(query);
+    }
+
+    std::string FanOut::execute(const std::string& cmd)
+    {
+        auto& primary = *replicas_.front();
+        std::lock_guard transportLock{primary.transportMutex};
+        return primary.transport->execute(cmd);
+    }
+
+    void FanOut::createDatabase()
+    {
+        forEachReplica([](Transport& transport)
+                       { transport.createDatabase(); });
+    }
+
+    void FanOut::setProxy(const Proxy& proxy)
+    {
+        forEachReplica([&proxy](Transport& transport)
+                       { transport.setProxy(proxy); });
+    }
+
+    void FanOut::setTimePrecision(TimePrecision precision)
+    {
+        forEachReplica([precision](Transport& transport)
+                       { transport.setTimePrecision(precision); });
+    }
+
+    void FanOut::setQueryEpoch(TimePrecision epoch)
+    {
+        forEachReplica([epoch](Transport& transport)
+                       { transport.setQueryEpoch(epoch); });
+    }
+
+    void FanOut::setTimeout(std::chrono::milliseconds timeout)
+    {
+        forEachReplica([timeout](Transport& transport)
+                       { transport.setTimeout(timeout); });
+    }
+
+    bool FanOut::ping()
+    {
+        auto& primary = *replicas_.front();
+        std::lock_guard transportLock{primary.transportMutex};
+        return primary.transport->ping();
+    }
+
+    bool FanOut::drain(std::chrono::milliseconds timeout)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+        for (auto& replica : replicas_)
+        {
+            std::unique_lock lock{replica->mutex};
+            if (!replica->condition.wait_until(lock, deadline, [&replica]
+                                               { return replica->queue.empty() && !replica->sending; }))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    FanOutStats FanOut::stats(std::size_t replica) const
+    {
+        const auto& state = *replicas_.at(replica);
+        std::lock_guard lock{state.mutex};
+        return {state.queue.size() + (state.sending ? 1 : 0), state.sent, state.dropped};
+    }
+
+    void FanOut::deliver(Replica& replica)
+    {
+        std::unique_lock lock{replica.mutex};
+
+        while (true)
+        {
+            replica.condition.wait(lock, [&replica]
+                                   { return replica.stop || !replica.queue.empty(); });
+            if (replica.stop)
+            {
+                return;
+            }
+
+            const auto message = std::move(replica.queue.front());
+            replica.queue.pop_front();
+            replica.sending = true;
+            lock.unlock();
+
+            // The transport takes the payload over, it's copied again only for a retry
+            std::string payload{*message};
+            bool sent{false};
+            for (std::size_t attempt = 1; !sent; ++attempt)
+            {
+                try
+                {
+                    std::lock_guard transportLock{replica.transportMutex};
+                    replica.transport->send(std::move(payload));
+                    sent = true;
+                }
+                catch (const InfluxDBException& e)
+                {
+                    if (attempt >= options_.retryPolicy.maxAttempts || !isTransient(e))
+                    {
+                        break;
+                    }
+                    payload = *message;
+
+                    lock.lock();
+                    const auto stopped = replica.condition.wait_for(lock, options_.retryPolicy.backoff(attempt), [&replica]
+                                                                    { return replica.stop; });
+                    lock.unlock();
+
+                    if (stopped)
+                    {
+                        break;
+                    }
+                }
+            }
+
+            lock.lock();
+            replica.sending = false;
+            ++(sent ? replica.sent : replica.dropped);
+            replica.condition.notify_all();
+        }
+    }
+
+    template <class Function>
+    void FanOut::forEachReplica(Function function)
+    {
+        for (auto& replica : replicas_)
+        {
+            std::lock_guard transportLock{replica->transportMutex};
+            function(*replica->transport);
+        }
+    }
+}
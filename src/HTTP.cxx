@@ -27,20 +27,241 @@
 
 #include "HTTP.h"
 #include "InfluxDB/InfluxDBException.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 namespace influxdb::transports
 {
     namespace
     {
+        // Extracts the message of an error body ({"error": "..."} or v2's {"message": "..."}),
+        // anything else is returned as is
+        std::string parseErrorMessage(const std::string& body)
+        {
+            constexpr std::string_view whitespace{" \t\r\n"};
+
+            for (const std::string_view key : {R"("error")", R"("message")"})
+            {
+                auto pos = body.find(key);
+                if (pos == std::string::npos)
+                {
+                    continue;
+                }
+                pos = body.find_first_not_of(whitespace, pos + key.size());
+                if (pos == std::string::npos || body[pos] != ':')
+                {
+                    continue;
+                }
+                pos = body.find_first_not_of(whitespace, pos + 1);
+                if (pos == std::string::npos || body[pos] != '"')
+                {
+                    continue;
+                }
+
+                std::string message;
+                for (++pos; pos < body.size() && body[pos] != '"'; ++pos)
+                {
+                    if (body[pos] == '\\' && pos + 1 < body.size())
+                    {
+                        ++pos;
+                        switch (body[pos])
+                        {
+                            case 'n':
+                                message += '\n';
+                                break;
+                            case 't':
+                                message += '\t';
+                                break;
+                            default:
+                                message += body[pos];
+                                break;
+                        }
+                        continue;
+                    }
+                    message += body[pos];
+                }
+                return message;
+            }
+            return body;
+        }
+
         void checkResponse(const cpr::Response& resp)
         {
             if (resp.error)
             {
-                throw InfluxDBException{"Request error: (" + std::to_string(static_cast<int>(resp.error.code)) + ") " + resp.error.message};
+                throw ConnectionException{"Request error: (" + std::to_string(static_cast<int>(resp.error.code)) + ") " + resp.error.message};
             }
             if (!cpr::status::is_success(resp.status_code))
             {
-                throw InfluxDBException{"Request failed: (" + std::to_string(resp.status_code) + ") " + resp.reason + " (message: '" + resp.text + "')"};
+                throw RequestFailedException{"Request failed: (" + std::to_string(resp.status_code) + ") " + resp.reason + " (message: '" + parseErrorMessage(resp.text) + "')", resp.status_code};
+            }
+        }
+
+        bool isRejectedLines(const cpr::Response& resp)
+        {
+            if (resp.error || resp.status_code != cpr::status::HTTP_BAD_REQUEST)
+            {
+                return false;
+            }
+            const auto message = parseErrorMessage(resp.text);
+            return message.find("partial write") != std::string::npos || message.find("unable to parse") != std::string::npos;
+        }
+
+        // The server stored the valid lines of a partial write, only parse errors
+        // without it reject the whole request
+        bool isPartialWrite(const std::string& error)
+        {
+            return error.find("partial write") != std::string::npos;
+        }
+
+        // Lines named by a partial write error, either quoted (v1's "unable to
+        // parse '<line>': <reason>") or numbered (v2's "line <n>: <reason>")
+        std::vector<std::string_view> rejectedLinesOf(std::span<const std::string_view> lines, std::string_view error)
+        {
+            std::vector<bool> isRejected(lines.size(), false);
+
+            constexpr std::string_view quoted{"unable to parse '"};
+            for (auto pos = error.find(quoted); pos != std::string_view::npos; pos = error.find(quoted, pos))
+            {
+                pos += quoted.size();
+                const auto end = error.find("': ", pos);
+                if (end == std::string_view::npos)
+                {
+                    break;
+                }
+                if (const auto line = std::find(lines.begin(), lines.end(), error.substr(pos, end - pos)); line != lines.end())
+                {
+                    isRejected[static_cast<std::size_t>(std::distance(lines.begin(), line))] = true;
+                }
+                pos = end;
+            }
+
+            constexpr std::string_view numbered{"line "};
+            for (auto pos = error.find(numbered); pos != std::string_view::npos; pos = error.find(numbered, pos))
+            {
+                pos += numbered.size();
+                std::size_t number{0};
+                if (const auto [ptr, ec] = std::from_chars(error.data() + pos, error.data() + error.size(), number);
+                    ec == std::errc{} && ptr != error.data() + error.size() && *ptr == ':' && number >= 1 && number <= lines.size())
+                {
+                    isRejected[number - 1] = true;
+                }
+            }
+
+            std::vector<std::string_view> rejected;
+            for (std::size_t i = 0; i < lines.size(); ++i)
+            {
+                if (isRejected[i])
+                {
+                    rejected.push_back(lines[i]);
+                }
+            }
+            return rejected;
+        }
+
+        std::vector<std::string_view> splitLines(std::string_view lineprotocol)
+        {
+            std::vector<std::string_view> lines;
+            while (!lineprotocol.empty())
+            {
+                const auto end = std::min(lineprotocol.find('\n'), lineprotocol.size());
+                if (end > 0)
+                {
+                    lines.push_back(lineprotocol.substr(0, end));
+                }
+                lineprotocol.remove_prefix(std::min(end + 1, lineprotocol.size()));
+            }
+            return lines;
+        }
+
+        std::string joinLines(std::span<const std::string_view> lines)
+        {
+            std::string joined;
+            for (const auto& line : lines)
+            {
+                joined.append(line).append("\n");
+            }
+            if (!joined.empty())
+            {
+                joined.pop_back();
+            }
+            return joined;
+        }
+
+        bool isRetryable(const cpr::Response& resp)
+        {
+            if (resp.error)
+            {
+                return true; // Connection failures and timeouts
+            }
+            return RetryPolicy::isRetryableStatus(resp.status_code);
+        }
+
+        // Status of a status line (eg. "HTTP/1.1 200 OK"), other header lines have none
+        std::optional<long> parseStatus(std::string_view header)
+        {
+            if (!header.starts_with("HTTP/"))
+            {
+                return std::nullopt;
+            }
+            const auto space = header.find(' ');
+            if (space == std::string_view::npos)
+            {
+                return std::nullopt;
+            }
+            long status{0};
+            if (const auto [ptr, ec] = std::from_chars(header.data() + space + 1, header.data() + header.size(), status); ec != std::errc{})
+            {
+                return std::nullopt;
+            }
+            return status;
+        }
+
+        std::optional<std::chrono::seconds> parseRetryAfter(const cpr::Response& resp)
+        {
+            const auto header = resp.header.find("Retry-After");
+            if (header == resp.header.end())
+            {
+                return std::nullopt;
+            }
+
+            // Only the delay-seconds form is supported, HTTP dates fall back to the backoff
+            const auto& value = header->second;
+            long long int seconds{0};
+            if (const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), seconds); ec != std::errc{} || seconds < 0)
+            {
+                return std::nullopt;
+            }
+            return std::chrono::seconds{seconds};
+        }
+
+        cpr::Response requestWithRetries(const RetryPolicy& policy, const std::function<cpr::Response()>& request)
+        {
+            for (std::size_t attempt = 1;; ++attempt)
+            {
+                auto response = request();
+
+                if (attempt >= policy.maxAttempts || !isRetryable(response))
+                {
+                    return response;
+                }
+
+                auto delay = policy.backoff(attempt);
+                if (const auto retryAfter = parseRetryAfter(response); retryAfter)
+                {
+                    // Bounded by the policy, a server must not block the client for arbitrary time
+                    const auto bounded = *retryAfter > std::chrono::duration_cast<std::chrono::seconds>(policy.maxBackoff) ? policy.maxBackoff : std::chrono::milliseconds{*retryAfter};
+                    delay = std::max(delay, bounded);
+                }
+                std::this_thread::sleep_for(delay);
             }
         }
 
@@ -59,6 +280,32 @@ namespace influxdb::transports
             return url.substr(0, questionMarkPosition);
         }
 
+        std::optional<std::string> parseParameter(const std::string& url, std::string_view name)
+        {
+            const auto questionMarkPosition = url.find('?');
+
+            if (questionMarkPosition == std::string::npos)
+            {
+                return std::nullopt;
+            }
+
+            std::string_view parameters{url};
+            parameters.remove_prefix(questionMarkPosition + 1);
+
+            while (!parameters.empty())
+            {
+                const auto end = std::min(parameters.find('&'), parameters.size());
+                const auto parameter = parameters.substr(0, end);
+
+                if (parameter.size() > name.size() && parameter.starts_with(name) && parameter[name.size()] == '=')
+                {
+                    return std::string{parameter.substr(name.size() + 1)};
+                }
+                parameters.remove_prefix(std::min(end + 1, parameters.size()));
+            }
+            return std::nullopt;
+        }
+
         std::string parseDatabaseName(const std::string& url)
         {
             const auto dbParameterPosition = url.find("?db=");
@@ -67,14 +314,62 @@ namespace influxdb::transports
             {
                 throw InfluxDBException{"No Database specified"};
             }
-            return url.substr(dbParameterPosition + 4);
+            const auto nameBegin = dbParameterPosition + 4;
+            return url.substr(nameBegin, url.find('&', nameBegin) - nameBegin);
+        }
+
+        // The v2 write API supports ns, us, ms and s only
+        std::string toV2PrecisionString(const std::string& precision)
+        {
+            if (precision == "u")
+            {
+                return "us";
+            }
+            if (precision == "h" || precision == "m")
+            {
+                throw InfluxDBException{"Time precision '" + precision + "' is not supported by the v2 write API"};
+            }
+            return precision;
+        }
+
+        std::string toPrecisionString(TimePrecision precision)
+        {
+            switch (precision)
+            {
+                case TimePrecision::Hours:
+                    return "h";
+                case TimePrecision::Minutes:
+                    return "m";
+                case TimePrecision::Seconds:
+                    return "s";
+                case TimePrecision::MilliSeconds:
+                    return "ms";
+                case TimePrecision::MicroSeconds:
+                    return "u";
+                case TimePrecision::NanoSeconds:
+                default:
+                    return "ns";
+            }
         }
     }
 
 
     HTTP::HTTP(const std::string& url)
-        : endpointUrl(parseUrl(url)), databaseName(parseDatabaseName(url))
+        : endpointUrl(parseUrl(url))
     {
+        const auto org = parseParameter(url, "org");
+        const auto bucketName = parseParameter(url, "bucket");
+
+        if (org && bucketName && url.find("?db=") == std::string::npos)
+        {
+            databaseName = *bucketName;
+            setBucket(*org, *bucketName);
+        }
+        else
+        {
+            databaseName = parseDatabaseName(url);
+        }
+
         session.SetTimeout(cpr::Timeout{std::chrono::seconds{10}});
         session.SetConnectTimeout(cpr::ConnectTimeout{std::chrono::seconds{10}});
     }
@@ -89,14 +384,101 @@ namespace influxdb::transports
         {
             params.Add({"precision", timePrecision});
         }
+        if (!queryEpoch.empty())
+        {
+            params.Add({"epoch", queryEpoch});
+        }
         session.SetParameters(std::move(params));
 
-        const auto response = session.Get();
+        const auto response = requestWithRetries(retryPolicy, [this]
+                                                 { return session.Get(); });
         checkResponse(response);
 
         return response.text;
     }
 
+    void HTTP::queryChunked(const std::string& query, std::size_t chunkSize, const std::function<void(std::string_view)>& onChunk)
+    {
+        session.SetUrl(cpr::Url{endpointUrl + "/query"});
+
+        cpr::Parameters params{{"db", databaseName}, {"q", query}, {"chunked", "true"}, {"chunk_size", std::to_string(chunkSize)}};
+
+        if (!timePrecision.empty())
+        {
+            params.Add({"precision", timePrecision});
+        }
+        if (!queryEpoch.empty())
+        {
+            params.Add({"epoch", queryEpoch});
+        }
+        session.SetParameters(std::move(params));
+
+        // Each chunk is a separate, newline terminated JSON document; only an
+        // incomplete trailing chunk is kept in memory
+        std::string pending;
+        std::exception_ptr error;
+        std::optional<long> status;
+        const auto passChunks = [&pending, &onChunk]
+        {
+            std::size_t begin{0};
+            for (auto end = pending.find('\n'); end != std::string::npos; end = pending.find('\n', begin))
+            {
+                onChunk(std::string_view{pending}.substr(begin, end - begin));
+                begin = end + 1;
+            }
+            pending.erase(0, begin);
+        };
+        const auto inspectHeader = [&pending, &status](const std::string_view& header, [[maybe_unused]] std::intptr_t userdata)
+        {
+            // Each response (eg. of a redirect) starts with a status line
+            if (const auto lineStatus = parseStatus(header); lineStatus)
+            {
+                status = lineStatus;
+                pending.clear();
+            }
+            return true;
+        };
+        const auto consume = [&pending, &error, &status, &passChunks](const std::string_view& data, [[maybe_unused]] std::intptr_t userdata)
+        {
+            try
+            {
+                pending.append(data);
+
+                // Until the status is known to be successful the body may be an error, which is kept for the exception
+                if (status && cpr::status::is_success(*status))
+                {
+                    passChunks();
+                }
+                return true;
+            }
+            catch (...)
+            {
+                // Exceptions must not pass through curl, abort the transfer instead
+                error = std::current_exception();
+                return false;
+            }
+        };
+
+        session.SetHeaderCallback(cpr::HeaderCallback{inspectHeader});
+        session.SetWriteCallback(cpr::WriteCallback{consume});
+        auto response = session.Get();
+        session.SetWriteCallback(cpr::WriteCallback{});
+        session.SetHeaderCallback(cpr::HeaderCallback{});
+
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+        response.text = pending;
+        checkResponse(response);
+
+        passChunks();
+        if (!pending.empty())
+        {
+            onChunk(pending);
+        }
+    }
+
     void HTTP::setBasicAuthentication(const std::string& user, const std::string& pass)
     {
         session.SetAuth(cpr::Authentication{user, pass, cpr::AuthMode::BASIC});
@@ -109,22 +491,93 @@ namespace influxdb::transports
 
     void HTTP::send(std::string&& lineprotocol)
     {
-        session.SetUrl(cpr::Url{endpointUrl + "/write"});
-        session.UpdateHeader(cpr::Header{{"Content-Type", "application/json"}});
+        session.UpdateHeader(cpr::Header{{"Content-Type", "text/plain; charset=utf-8"}});
 
-        cpr::Parameters params{{"db", databaseName}};
+        if (bucket.empty())
+        {
+            session.SetUrl(cpr::Url{endpointUrl + "/write"});
 
-        if (!timePrecision.empty())
+            cpr::Parameters params{{"db", databaseName}};
+
+            if (!timePrecision.empty())
+            {
+                params.Add({"precision", timePrecision});
+            }
+            session.SetParameters(std::move(params));
+        }
+        else
         {
-            params.Add({"precision", timePrecision});
+            session.SetUrl(cpr::Url{endpointUrl + "/api/v2/write"});
+
+            cpr::Parameters params{{"org", organization}, {"bucket", bucket}};
+
+            if (!timePrecision.empty())
+            {
+                params.Add({"precision", toV2PrecisionString(timePrecision)});
+            }
+            session.SetParameters(std::move(params));
         }
-        session.SetParameters(std::move(params));
-        session.SetBody(cpr::Body{lineprotocol});
 
-        const auto response = session.Post();
+        const auto response = post(lineprotocol);
+
+        if (partialWriteHandler && isRejectedLines(response))
+        {
+            isolateRejectedLines(splitLines(lineprotocol), parseErrorMessage(response.text));
+            return;
+        }
         checkResponse(response);
     }
 
+    cpr::Response HTTP::post(const std::string& body)
+    {
+        session.SetBody(cpr::Body{body});
+        return requestWithRetries(retryPolicy, [this]
+                                  { return session.Post(); });
+    }
+
+    void HTTP::isolateRejectedLines(std::span<const std::string_view> lines, const std::string& error)
+    {
+        if (isPartialWrite(error))
+        {
+            // Resending would duplicate the stored lines; unnamed lines are reported as empty line
+            const auto rejected = rejectedLinesOf(lines, error);
+            if (rejected.empty())
+            {
+                partialWriteHandler({}, error);
+            }
+            for (const auto& line : rejected)
+            {
+                partialWriteHandler(line, error);
+            }
+            return;
+        }
+
+        if (lines.size() <= 1)
+        {
+            for (const auto& line : lines)
+            {
+                partialWriteHandler(line, error);
+            }
+            return;
+        }
+
+        const auto half = lines.size() / 2;
+
+        for (const auto part : {lines.first(half), lines.subspan(half)})
+        {
+            const auto response = post(joinLines(part));
+
+            if (isRejectedLines(response))
+            {
+                isolateRejectedLines(part, parseErrorMessage(response.text));
+            }
+            else
+            {
+                checkResponse(response);
+            }
+        }
+    }
+
     void HTTP::setProxy(const Proxy& proxy)
     {
         session.SetProxies(cpr::Proxies{{"http", proxy.getProxy()}, {"https", proxy.getProxy()}});
@@ -141,36 +594,45 @@ namespace influxdb::transports
         session.SetVerifySsl(verify);
     }
 
+    void HTTP::setHttp2(bool enable)
+    {
+        session.SetHttpVersion(cpr::HttpVersion{enable ? cpr::HttpVersionCode::VERSION_2_0 : cpr::HttpVersionCode::VERSION_NONE});
+    }
+
     void HTTP::setTimeout(std::chrono::milliseconds timeout)
     {
         session.SetTimeout(timeout);
         session.SetConnectTimeout(timeout);
     }
 
-    void HTTP::setTimePrecision(TimePrecision precision)
+    void HTTP::setBucket(const std::string& org, const std::string& bucketName)
     {
-        switch (precision)
-        {
-            case TimePrecision::Hours:
-                timePrecision = "h";
-                break;
-            case TimePrecision::Minutes:
-                timePrecision = "m";
-                break;
-            case TimePrecision::Seconds:
-                timePrecision = "s";
-                break;
-            case TimePrecision::MilliSeconds:
-                timePrecision = "ms";
-                break;
-            case TimePrecision::MicroSeconds:
-                timePrecision = "u";
-                break;
-            case TimePrecision::NanoSeconds:
-            default:
-                timePrecision = "ns";
-                break;
+        if (org.empty() || bucketName.empty())
+        {
+            throw InfluxDBException{"Organization and bucket must not be empty"};
         }
+        organization = org;
+        bucket = bucketName;
+    }
+
+    void HTTP::setRetryPolicy(const RetryPolicy& policy)
+    {
+        retryPolicy = policy;
+    }
+
+    void HTTP::setPartialWriteHandler(PartialWriteHandler handler)
+    {
+        partialWriteHandler = std::move(handler);
+    }
+
+    void HTTP::setTimePrecision(TimePrecision precision)
+    {
+        timePrecision = toPrecisionString(precision);
+    }
+
+    void HTTP::setQueryEpoch(TimePrecision epoch)
+    {
+        queryEpoch = toPrecisionString(epoch);
     }
 
     bool HTTP::ping()
@@ -30,8 +30,12 @@
 
 #include "InfluxDB/Transport.h"
 #include "InfluxDB/TimePrecision.h"
+#include "InfluxDB/RetryPolicy.h"
 #include <string>
+#include <string_view>
 #include <chrono>
+#include <functional>
+#include <span>
 #include <cpr/cpr.h>
 
 namespace influxdb::transports
@@ -41,10 +45,15 @@ namespace influxdb::transports
     class HTTP : public Transport
     {
     public:
-        /// Constructor
+        /// Handler of a line rejected by the server and the server's error message
+        using PartialWriteHandler = std::function<void(std::string_view line, const std::string& error)>;
+
+        /// Constructor, the url selects the v1 write API by "?db=<database>" or the v2
+        /// one by "?org=<organization>&bucket=<bucket>"
         explicit HTTP(const std::string& url);
 
-        /// Sends point via HTTP POST
+        /// Sends point via HTTP POST, either to the v1 write endpoint or the v2 one
+        /// if a bucket is set
         ///  \throw InfluxDBException	when send fails
         void send(std::string&& lineprotocol) override;
 
@@ -52,6 +61,10 @@ namespace influxdb::transports
         /// \throw InfluxDBException	when query fails
         std::string query(const std::string& query) override;
 
+        /// Queries database in chunked mode, consuming the response incrementally
+        /// \throw InfluxDBException	when query fails
+        void queryChunked(const std::string& query, std::size_t chunkSize, const std::function<void(std::string_view)>& onChunk) override;
+
         /// Execute command
         /// \throw InfluxDBException    when execution fails
         std::string execute(const std::string& cmd) override;
@@ -73,14 +86,47 @@ namespace influxdb::transports
         void setProxy(const Proxy& proxy) override;
 
         void setVerifyCertificate(bool verify);
-        void setTimeout(std::chrono::milliseconds timeout);
+
+        /// Negotiates HTTP/2 (ALPN on TLS connections), falls back to HTTP/1.1 if not
+        /// supported by the server; disabled uses curl's default
+        void setHttp2(bool enable);
+
+        void setTimeout(std::chrono::milliseconds timeout) override;
+
+        /// Writes to the v2 API (/api/v2/write) of the given organization and bucket
+        /// instead of the v1 one; queries use the v1 compatibility endpoint with the
+        /// database name given by the url (or the bucket if there's none)
+        /// \throw InfluxDBException	if organization or bucket is empty
+        void setBucket(const std::string& org, const std::string& bucketName);
+
+        /// Sets the retry policy of writes and queries failing with a transient
+        /// error (connection failures, timeouts, 408, 429, 500, 502, 503, 504);
+        /// a Retry-After header of the response extends the backoff
+        void setRetryPolicy(const RetryPolicy& policy);
+
+        /// Sets a handler of lines rejected by the server (partial write, parse errors),
+        /// which are reported to the handler and dropped instead of failing the batch.
+        /// The valid lines of a partial write are stored by the server, so the rejected
+        /// ones are taken from the error message (an empty line if it names none); a
+        /// batch rejected as a whole by a parse error is bisected and resent to isolate them
+        void setPartialWriteHandler(PartialWriteHandler handler);
+
         void setTimePrecision(TimePrecision precision) override;
+        void setQueryEpoch(TimePrecision epoch) override;
         bool ping() override;
 
     private:
+        cpr::Response post(const std::string& body);
+        void isolateRejectedLines(std::span<const std::string_view> lines, const std::string& error);
+
         std::string endpointUrl;
         std::string databaseName;
+        std::string organization;
+        std::string bucket;
         std::string timePrecision;
+        std::string queryEpoch;
+        RetryPolicy retryPolicy;
+        PartialWriteHandler partialWriteHandler;
         cpr::Session session;
     };
 
@@ -26,20 +26,205 @@
 ///
 
 #include "InfluxDB/InfluxDB.h"
+#include "InfluxDB/ArenaPoint.h"
 #include "InfluxDB/InfluxDBException.h"
 #include "LineProtocol.h"
 #include "BoostSupport.h"
+#include "SeriesKey.h"
+#include <algorithm>
+#include <chrono>
+#include <iterator>
 
 namespace influxdb
 {
+    namespace
+    {
+#ifdef INFLUXCXX_WITH_METRICS
+        constexpr bool metricsEnabled{true};
+#else
+        constexpr bool metricsEnabled{false};
+#endif
+
+        std::string batchKeyOf(const Point& point)
+        {
+            // Points without timestamp of one request get the same timestamp by the server
+            const auto timestamp = point.hasTimestamp() ? std::to_string(point.getTimestamp().time_since_epoch().count()) : "";
+            return internal::seriesKey(point) + '\0' + timestamp;
+        }
+
+        // Fields of the earlier point which are not set by the later one are retained, as by the server
+        Point coalesce(const Point& earlier, Point&& later)
+        {
+            for (const auto& [name, value] : earlier.getFieldSet())
+            {
+                const auto& fields = later.getFieldSet();
+
+                if (std::none_of(fields.cbegin(), fields.cend(), [&name](const auto& field)
+                                 { return field.first == name; }))
+                {
+                    later.addField(name, value);
+                }
+            }
+            return std::move(later);
+        }
+
+        std::chrono::nanoseconds elapsedSince(std::chrono::steady_clock::time_point start)
+        {
+            return std::chrono::steady_clock::now() - start;
+        }
+
+        /// Serves queries of the wrapped transport through a query cache
+        class CachedQueryTransport : public Transport
+        {
+        public:
+            CachedQueryTransport(Transport& transport, QueryCache& cache, std::optional<TimePrecision> epoch)
+                : transport_(transport), cache_(cache), keyPrefix_(epoch ? std::to_string(static_cast<int>(*epoch)) : "")
+            {
+            }
+
+            void send(std::string&& message) override
+            {
+                transport_.send(std::move(message));
+            }
+
+            std::string query(const std::string& query) override
+            {
+                if (!QueryCache::isCacheable(query))
+                {
+                    return transport_.query(query);
+                }
+
+                // Responses differ by the requested epoch precision
+                return cache_.get(keyPrefix_ + ";" + query, [this, &query]
+                                  { return transport_.query(query); });
+            }
+
+        private:
+            Transport& transport_;
+            QueryCache& cache_;
+            std::string keyPrefix_;
+        };
+
+        /// Span of a tracer, ended on destruction at the latest; no-op without a tracer
+        class ScopedSpan
+        {
+        public:
+            ScopedSpan(Tracer* tracer, TraceSpan span)
+                : tracer_(tracer), span_(span)
+            {
+                if (tracer_ != nullptr)
+                {
+                    tracer_->begin(span_);
+                }
+            }
+
+            ~ScopedSpan()
+            {
+                end();
+            }
+
+            ScopedSpan(const ScopedSpan&) = delete;
+            ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+            void end()
+            {
+                if (tracer_ != nullptr)
+                {
+                    tracer_->end(span_);
+                    tracer_ = nullptr;
+                }
+            }
+
+        private:
+            Tracer* tracer_;
+            TraceSpan span_;
+        };
+
+        /// Traces the query requests of the wrapped transport; the decoding of
+        /// the response is traced until the next request or destruction
+        class TracedQueryTransport : public Transport
+        {
+        public:
+            TracedQueryTransport(Transport& transport, Tracer& tracer)
+                : transport_(transport), tracer_(tracer), decode_{}
+            {
+            }
+
+            void send(std::string&& message) override
+            {
+                transport_.send(std::move(message));
+            }
+
+            std::string query(const std::string& query) override
+            {
+                decode_.reset();
+                std::string response;
+                {
+                    ScopedSpan request{&tracer_, TraceSpan::Query};
+                    response = transport_.query(query);
+                }
+                decode_.emplace(&tracer_, TraceSpan::Decode);
+                return response;
+            }
+
+            void queryChunked(const std::string& query, std::size_t chunkSize, const std::function<void(std::string_view)>& onChunk) override
+            {
+                ScopedSpan request{&tracer_, TraceSpan::Query};
+                transport_.queryChunked(query, chunkSize, [this, &onChunk](std::string_view chunk)
+                                        {
+                                            ScopedSpan decode{&tracer_, TraceSpan::Decode};
+                                            onChunk(chunk);
+                                        });
+            }
+
+        private:
+            Transport& transport_;
+            Tracer& tracer_;
+            std::optional<ScopedSpan> decode_;
+        };
+
+        /// Executes a query through the query cache and tracer, if set
+        template <class Result>
+        Result queryThrough(Transport& transport, QueryCache* cache, Tracer* tracer, std::optional<TimePrecision> epoch, const std::function<Result(Transport*)>& execute)
+        {
+            Transport* target = &transport;
+
+            std::optional<CachedQueryTransport> cached;
+            if (cache != nullptr)
+            {
+                target = &cached.emplace(*target, *cache, epoch);
+            }
+
+            std::optional<TracedQueryTransport> traced;
+            if (tracer != nullptr)
+            {
+                target = &traced.emplace(*target, *tracer);
+            }
+            return execute(target);
+        }
+    }
 
     InfluxDB::InfluxDB(std::unique_ptr<Transport> transport)
         : mPointBatch{},
+          mLineBatch{},
+          mLineBatchSize{0},
           mIsBatchingActivated{false},
           mBatchSize{0},
+          mIsBatchCoalescing{false},
+          mBatchIndex{},
+          mIsSeriesOrdering{false},
           mTransport(std::move(transport)),
           mGlobalTags{},
-          timePrecision{TimePrecision::NanoSeconds}
+          timePrecision{TimePrecision::NanoSeconds},
+          mQueryEpoch{},
+          mQueryDecodePool{},
+          mQueryCache{},
+          mMetrics{},
+          mSelfMonitoringPoint{},
+          mSelfMonitoringInterval{0},
+          mNextSelfMonitoring{},
+          mTracer{},
+          mAggregator{}
     {
         if (mTransport == nullptr)
         {
@@ -47,6 +232,8 @@ namespace influxdb
         }
     }
 
+    InfluxDB::~InfluxDB() = default;
+
     void InfluxDB::batchOf(std::size_t size)
     {
         mBatchSize = size;
@@ -55,33 +242,100 @@ namespace influxdb
 
     std::size_t InfluxDB::batchSize() const
     {
-        return mPointBatch.size();
+        return mPointBatch.size() + mLineBatchSize;
     }
 
     void InfluxDB::clearBatch()
     {
         mPointBatch.clear();
+        mLineBatch.clear();
+        mLineBatchSize = 0;
+        mBatchIndex.clear();
+    }
+
+    void InfluxDB::setBatchCoalescing(bool enabled)
+    {
+        mIsBatchCoalescing = enabled;
+        mBatchIndex.clear();
+    }
+
+    void InfluxDB::setSeriesOrdering(bool enabled)
+    {
+        mIsSeriesOrdering = enabled;
     }
 
     void InfluxDB::flushBatch()
     {
-        if (mIsBatchingActivated && !mPointBatch.empty())
+        emitSelfMonitoring();
+
+        if (mIsBatchingActivated && batchSize() > 0)
         {
-            transmit(joinLineProtocolBatch());
+            const auto start = std::chrono::steady_clock::now();
+            const auto points = batchSize();
+
+            // Cleared before transmitting, a failed batch must not be sent again with the next one
+            auto lineProtocol = joinLineProtocolBatch();
             mPointBatch.clear();
+            mBatchIndex.clear();
+
+            if constexpr (metricsEnabled)
+            {
+                mMetrics.addBytesSerialized(lineProtocol.size());
+
+                try
+                {
+                    transmit(std::move(lineProtocol), points);
+                }
+                catch (...)
+                {
+                    mMetrics.addBatchFlushed(points, elapsedSince(start));
+                    throw;
+                }
+                mMetrics.addBatchFlushed(points, elapsedSince(start));
+            }
+            else
+            {
+                transmit(std::move(lineProtocol), points);
+            }
         }
     }
 
-    std::string InfluxDB::joinLineProtocolBatch() const
+    std::string InfluxDB::joinLineProtocolBatch()
     {
-        std::string joinedBatch;
+        // The points written as lines are taken over, not copied
+        std::string joinedBatch{std::move(mLineBatch)};
+        mLineBatch.clear();
+        mLineBatchSize = 0;
 
-        LineProtocol formatter{mGlobalTags, timePrecision};
-        for (const auto& point : mPointBatch)
+        ScopedSpan serialize{mTracer.get(), TraceSpan::Serialize};
+        LineProtocol formatter{mGlobalTags, timePrecision, mIsSeriesOrdering};
+        if (mIsSeriesOrdering)
         {
-            joinedBatch += formatter.format(point) + "\n";
-        }
+            std::vector<std::pair<std::string, const Point*>> series;
+            series.reserve(mPointBatch.size());
 
+            for (const auto& point : mPointBatch)
+            {
+                series.emplace_back(internal::seriesKey(point), &point);
+            }
+            // Stable to keep points of a series in write order
+            std::stable_sort(series.begin(), series.end(), [](const auto& a, const auto& b)
+                             { return a.first < b.first; });
+
+            for (const auto& [key, point] : series)
+            {
+                formatter.formatTo(joinedBatch, *point);
+                joinedBatch += '\n';
+            }
+        }
+        else
+        {
+            for (const auto& point : mPointBatch)
+            {
+                formatter.formatTo(joinedBatch, point);
+                joinedBatch += '\n';
+            }
+        }
         joinedBatch.erase(std::prev(joinedBatch.end()));
         return joinedBatch;
     }
@@ -98,26 +352,108 @@ namespace influxdb
         mGlobalTags += LineProtocol::EscapeStringElement(LineProtocol::ElementType::TagValue, value);
     }
 
-    void InfluxDB::transmit(std::string&& point)
+    void InfluxDB::transmit(std::string&& point, [[maybe_unused]] std::size_t points)
     {
-        mTransport->send(std::move(point));
+        ScopedSpan send{mTracer.get(), TraceSpan::Send};
+
+        if constexpr (metricsEnabled)
+        {
+            const auto start = std::chrono::steady_clock::now();
+
+            try
+            {
+                mTransport->send(std::move(point));
+            }
+            catch (...)
+            {
+                mMetrics.addTransmit(elapsedSince(start), true);
+                mMetrics.addPointsDropped(points);
+                throw;
+            }
+            mMetrics.addTransmit(elapsedSince(start), false);
+        }
+        else
+        {
+            mTransport->send(std::move(point));
+        }
+    }
+
+    void InfluxDB::write(const ArenaPoint& point)
+    {
+        if (mAggregator || mIsBatchCoalescing || mIsSeriesOrdering)
+        {
+            write(point.toPoint());
+        }
+        else
+        {
+            writeLine([&point](LineWriter& writer)
+                      { point.formatTo(writer); });
+        }
     }
 
     void InfluxDB::write(Point&& point)
     {
-        if (mIsBatchingActivated)
+        if constexpr (metricsEnabled)
+        {
+            mMetrics.addPointsWritten(1);
+        }
+
+        if (mAggregator)
+        {
+            writePoints(mAggregator->add(std::move(point)));
+        }
+        else if (mIsBatchingActivated)
         {
             addPointToBatch(std::move(point));
         }
         else
         {
-            LineProtocol formatter{mGlobalTags, timePrecision};
-            transmit(formatter.format(point));
+            ScopedSpan serialize{mTracer.get(), TraceSpan::Serialize};
+            LineProtocol formatter{mGlobalTags, timePrecision, mIsSeriesOrdering};
+            auto lineProtocol = formatter.format(point);
+            serialize.end();
+
+            if constexpr (metricsEnabled)
+            {
+                mMetrics.addBytesSerialized(lineProtocol.size());
+            }
+            transmit(std::move(lineProtocol), 1);
         }
+        emitSelfMonitoring();
     }
 
     void InfluxDB::write(std::vector<Point>&& points)
     {
+        if constexpr (metricsEnabled)
+        {
+            mMetrics.addPointsWritten(points.size());
+        }
+
+        if (mAggregator)
+        {
+            std::vector<Point> aggregates;
+
+            for (auto&& point : points)
+            {
+                auto completed = mAggregator->add(std::move(point));
+                std::move(completed.begin(), completed.end(), std::back_inserter(aggregates));
+            }
+            writePoints(std::move(aggregates));
+        }
+        else
+        {
+            writePoints(std::move(points));
+        }
+        emitSelfMonitoring();
+    }
+
+    void InfluxDB::writePoints(std::vector<Point>&& points)
+    {
+        if (points.empty())
+        {
+            return;
+        }
+
         if (mIsBatchingActivated)
         {
             for (auto&& point : points)
@@ -127,16 +463,38 @@ namespace influxdb
         }
         else
         {
+            ScopedSpan serialize{mTracer.get(), TraceSpan::Serialize};
             std::string lineProtocol;
-            LineProtocol formatter{mGlobalTags, timePrecision};
+            LineProtocol formatter{mGlobalTags, timePrecision, mIsSeriesOrdering};
 
             for (const auto& point : points)
             {
-                lineProtocol += formatter.format(point) + "\n";
+                formatter.formatTo(lineProtocol, point);
+                lineProtocol += '\n';
             }
 
             lineProtocol.erase(std::prev(lineProtocol.end()));
-            transmit(std::move(lineProtocol));
+            serialize.end();
+
+            if constexpr (metricsEnabled)
+            {
+                mMetrics.addBytesSerialized(lineProtocol.size());
+            }
+            transmit(std::move(lineProtocol), points.size());
+        }
+    }
+
+    void InfluxDB::setAggregator(std::unique_ptr<Aggregator> aggregator)
+    {
+        flushAggregation();
+        mAggregator = std::move(aggregator);
+    }
+
+    void InfluxDB::flushAggregation()
+    {
+        if (mAggregator)
+        {
+            writePoints(mAggregator->flush());
         }
     }
 
@@ -151,24 +509,176 @@ namespace influxdb
         mTransport->setTimePrecision(precision);
     }
 
+    void InfluxDB::setQueryEpoch(TimePrecision epoch)
+    {
+        mTransport->setQueryEpoch(epoch);
+        mQueryEpoch = epoch;
+    }
+
+    void InfluxDB::setQueryDecodeThreads(std::size_t threads)
+    {
+        mQueryDecodePool = (threads > 1 ? std::make_unique<internal::WorkerPool>(threads) : nullptr);
+    }
+
+    void InfluxDB::setQueryCache(std::shared_ptr<QueryCache> cache)
+    {
+        mQueryCache = std::move(cache);
+    }
+
+    void InfluxDB::setTracer(std::shared_ptr<Tracer> tracer)
+    {
+        mTracer = std::move(tracer);
+    }
+
     bool InfluxDB::ping()
     {
         return mTransport->ping();
     }
 
+    MetricsSnapshot InfluxDB::metrics() const
+    {
+        return mMetrics.snapshot();
+    }
+
+    void InfluxDB::setSelfMonitoring(std::chrono::milliseconds interval, Point prototype)
+    {
+        mSelfMonitoringPoint = std::move(prototype);
+        mSelfMonitoringInterval = interval;
+        mNextSelfMonitoring = std::chrono::steady_clock::now() + interval;
+    }
+
+    void InfluxDB::disableSelfMonitoring()
+    {
+        mSelfMonitoringPoint.reset();
+    }
+
+    void InfluxDB::emitSelfMonitoring()
+    {
+        const auto now = std::chrono::steady_clock::now();
+
+        if (!mSelfMonitoringPoint || now < mNextSelfMonitoring)
+        {
+            return;
+        }
+        // Updated first, emitting may flush the batch which checks again
+        mNextSelfMonitoring = now + mSelfMonitoringInterval;
+
+        const auto metrics = mMetrics.snapshot();
+        const auto counter = [](std::uint64_t value)
+        { return static_cast<long long int>(value); };
+
+        auto point = *mSelfMonitoringPoint;
+        point.addField("points_written", counter(metrics.pointsWritten))
+            .addField("points_dropped", counter(metrics.pointsDropped))
+            .addField("bytes_serialized", counter(metrics.bytesSerialized))
+            .addField("batches_flushed", counter(metrics.batchesFlushed))
+            .addField("batched_points", counter(metrics.batchedPoints))
+            .addField("transmits", counter(metrics.transmits))
+            .addField("transmit_errors", counter(metrics.transmitErrors))
+            .addField("flush_latency_p50_us", counter(LatencyHistogram::quantile(metrics.flushLatency, 0.5).count()))
+            .addField("flush_latency_p99_us", counter(LatencyHistogram::quantile(metrics.flushLatency, 0.99).count()))
+            .addField("transmit_latency_p50_us", counter(LatencyHistogram::quantile(metrics.transmitLatency, 0.5).count()))
+            .addField("transmit_latency_p99_us", counter(LatencyHistogram::quantile(metrics.transmitLatency, 0.99).count()))
+            .setTimestamp(std::chrono::system_clock::now());
+
+        if (mIsBatchingActivated)
+        {
+            addPointToBatch(std::move(point));
+        }
+        else
+        {
+            LineProtocol formatter{mGlobalTags, timePrecision, mIsSeriesOrdering};
+            transmit(formatter.format(point), 1);
+        }
+    }
+
     void InfluxDB::addPointToBatch(Point&& point)
     {
+        if (mIsBatchCoalescing)
+        {
+            const auto [itr, inserted] = mBatchIndex.try_emplace(batchKeyOf(point), mPointBatch.size());
+
+            if (!inserted)
+            {
+                auto& earlier = mPointBatch[itr->second];
+                earlier = coalesce(earlier, std::move(point));
+                return;
+            }
+        }
+
         mPointBatch.emplace_back(std::move(point));
 
-        if (mPointBatch.size() >= mBatchSize)
+        if (batchSize() >= mBatchSize)
         {
             flushBatch();
         }
     }
 
+    void InfluxDB::writeLine(const std::function<void(LineWriter&)>& format)
+    {
+        if constexpr (metricsEnabled)
+        {
+            mMetrics.addPointsWritten(1);
+        }
+
+        LineProtocol formatter{mGlobalTags, timePrecision};
+
+        if (mIsBatchingActivated)
+        {
+            // Points written before precede the line; no index to keep, coalescing is off
+            for (const auto& point : mPointBatch)
+            {
+                formatter.formatTo(mLineBatch, point);
+                mLineBatch += '\n';
+            }
+            mLineBatchSize += mPointBatch.size();
+            mPointBatch.clear();
+            mBatchIndex.clear();
+
+            auto writer = formatter.writerOf(mLineBatch);
+            format(writer);
+            mLineBatch += '\n';
+            ++mLineBatchSize;
+
+            if (batchSize() >= mBatchSize)
+            {
+                flushBatch();
+            }
+        }
+        else
+        {
+            ScopedSpan serialize{mTracer.get(), TraceSpan::Serialize};
+            std::string lineProtocol;
+            auto writer = formatter.writerOf(lineProtocol);
+            format(writer);
+            serialize.end();
+
+            if constexpr (metricsEnabled)
+            {
+                mMetrics.addBytesSerialized(lineProtocol.size());
+            }
+            transmit(std::move(lineProtocol), 1);
+        }
+        emitSelfMonitoring();
+    }
+
     std::vector<Point> InfluxDB::query(const std::string& query)
     {
-        return internal::queryImpl(mTransport.get(), query);
+        return queryThrough<std::vector<Point>>(*mTransport, mQueryCache.get(), mTracer.get(), mQueryEpoch, [this, &query](Transport* transport)
+                                                { return internal::queryImpl(transport, query, mQueryEpoch, mQueryDecodePool.get()); });
+    }
+
+    std::vector<std::vector<Point>> InfluxDB::queryStatements(const std::string& query)
+    {
+        return queryThrough<std::vector<std::vector<Point>>>(*mTransport, mQueryCache.get(), mTracer.get(), mQueryEpoch, [this, &query](Transport* transport)
+                                                             { return internal::queryStatementsImpl(transport, query, mQueryEpoch, mQueryDecodePool.get()); });
+    }
+
+    void InfluxDB::queryStream(const std::string& query, const std::function<void(Point&&)>& onPoint, std::size_t chunkSize)
+    {
+        // Streamed responses are not cached
+        queryThrough<void>(*mTransport, nullptr, mTracer.get(), mQueryEpoch, [this, &query, &onPoint, chunkSize](Transport* transport)
+                           { internal::queryStreamImpl(transport, query, chunkSize, mQueryEpoch, onPoint); });
     }
 
     void InfluxDB::createDatabaseIfNotExists()
@@ -65,6 +65,30 @@ namespace influxdb
         return std::move(*this);
     }
 
+    InfluxDBBuilder&& InfluxDBBuilder::setHttp2(bool enable)
+    {
+        dynamic_cast<transports::HTTP&>(*transport).setHttp2(enable);
+        return std::move(*this);
+    }
+
+    InfluxDBBuilder&& InfluxDBBuilder::setBucket(const std::string& organization, const std::string& bucket)
+    {
+        dynamic_cast<transports::HTTP&>(*transport).setBucket(organization, bucket);
+        return std::move(*this);
+    }
+
+    InfluxDBBuilder&& InfluxDBBuilder::setRetryPolicy(const RetryPolicy& policy)
+    {
+        dynamic_cast<transports::HTTP&>(*transport).setRetryPolicy(policy);
+        return std::move(*this);
+    }
+
+    InfluxDBBuilder&& InfluxDBBuilder::setPartialWriteHandler(std::function<void(std::string_view line, const std::string& error)> handler)
+    {
+        dynamic_cast<transports::HTTP&>(*transport).setPartialWriteHandler(std::move(handler));
+        return std::move(*this);
+    }
+
     InfluxDBBuilder InfluxDBBuilder::http(const std::string& url)
     {
         return InfluxDBBuilder{std::make_unique<transports::HTTP>(url)};
@@ -22,7 +22,12 @@
 
 #include "LineProtocol.h"
 
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
 #include <iomanip>
+#include <limits>
 #include <sstream>
 
 namespace influxdb
@@ -45,12 +50,13 @@ namespace influxdb
             }
         }
 
-        std::string escapeCharacters(std::string_view input, const std::string& escapedChars)
-        {
-            static const std::string escapeCharacter{"\\"};
-            std::string output;
-            output.reserve(input.size());
+        // https://docs.influxdata.com/influxdb/cloud/reference/syntax/line-protocol/#special-characters
+        constexpr std::string_view commaAndSpace{", "};
+        constexpr std::string_view commaEqualsAndSpace{",= "};
+        constexpr std::string_view doubleQuoteAndBackslash{R"("\)"};
 
+        void appendEscaped(std::string& output, std::string_view input, std::string_view escapedChars)
+        {
             std::size_t searchStartPos{0};
             // Find the first character that needs to be escaped
             std::size_t escapedCharacterPos{input.find_first_of(escapedChars, searchStartPos)};
@@ -59,7 +65,7 @@ namespace influxdb
                 // Append the characters between the previous escaped character and the current one
                 output.append(input, searchStartPos, escapedCharacterPos - searchStartPos);
                 // Append the escape character and the character to be escaped
-                output.append(escapeCharacter).append(1, input[escapedCharacterPos]);
+                output.append(1, '\\').append(1, input[escapedCharacterPos]);
                 // Update the search start index to the character after the escaped character
                 searchStartPos = escapedCharacterPos + 1;
                 // Find the next character that needs to be escaped
@@ -67,10 +73,67 @@ namespace influxdb
             }
             // Append remaining characters after the final escaped character
             output.append(input, searchStartPos);
+        }
 
+        std::string escapeCharacters(std::string_view input, std::string_view escapedChars)
+        {
+            std::string output;
+            output.reserve(input.size());
+            appendEscaped(output, input, escapedChars);
             return output;
         }
 
+        // Writes the digits directly into the line, without intermediate string
+        template <class T>
+        void appendNumber(std::string& line, T value)
+        {
+            std::array<char, std::numeric_limits<T>::digits10 + 3> digits{};
+            const auto result = std::to_chars(digits.data(), digits.data() + digits.size(), value);
+            line.append(digits.data(), result.ptr);
+        }
+
+        void appendFieldValue(std::string& line, long long int value)
+        {
+            appendNumber(line, value);
+            line.push_back('i');
+        }
+
+        void appendFieldValue(std::string& line, unsigned long long int value)
+        {
+            appendNumber(line, value);
+            line.push_back('u');
+        }
+
+        void appendFieldValue(std::string& line, double value)
+        {
+            std::array<char, 128> digits{};
+            const auto result = std::to_chars(digits.data(), digits.data() + digits.size(), value, std::chars_format::fixed, Point::floatsPrecision);
+
+            if (result.ec == std::errc{})
+            {
+                line.append(digits.data(), result.ptr);
+            }
+            else
+            {
+                // Too many digits for the buffer
+                std::ostringstream convert;
+                convert << std::setprecision(Point::floatsPrecision) << std::fixed << value;
+                line.append(convert.str());
+            }
+        }
+
+        void appendFieldValue(std::string& line, bool value)
+        {
+            line.append(value ? "true" : "false");
+        }
+
+        void appendFieldValue(std::string& line, std::string_view value)
+        {
+            line.push_back('"');
+            appendEscaped(line, value, doubleQuoteAndBackslash);
+            line.push_back('"');
+        }
+
         std::string formatTags(const Point::TagSet& tagsDeque)
         {
             std::string tags;
@@ -90,91 +153,172 @@ namespace influxdb
             return tags;
         }
 
+        // Splits escaped tags at unescaped separators
+        std::vector<std::pair<std::string, std::string>> splitTags(std::string_view tags)
+        {
+            std::vector<std::pair<std::string, std::string>> tagSet;
+            std::pair<std::string, std::string> tag;
+            std::string* element{&tag.first};
+
+            for (std::size_t i = 0; i < tags.size(); ++i)
+            {
+                if (tags[i] == '\\' && i + 1 < tags.size())
+                {
+                    element->append(tags, i, 2);
+                    ++i;
+                }
+                else if (tags[i] == '=' && element == &tag.first)
+                {
+                    element = &tag.second;
+                }
+                else if (tags[i] == ',')
+                {
+                    tagSet.push_back(std::move(tag));
+                    tag = {};
+                    element = &tag.first;
+                }
+                else
+                {
+                    element->push_back(tags[i]);
+                }
+            }
+
+            if (!tag.first.empty())
+            {
+                tagSet.push_back(std::move(tag));
+            }
+            return tagSet;
+        }
+
         std::string formatFields(const Point::FieldSet& fieldsDeque)
         {
-            std::stringstream convert;
-            convert << std::setprecision(Point::floatsPrecision) << std::fixed;
-            bool addComma{false};
+            std::string fields;
             for (const auto& field : fieldsDeque)
             {
-                if (addComma)
+                if (!fields.empty())
                 {
-                    convert << ',';
+                    fields += ',';
                 }
 
-                convert << LineProtocol::EscapeStringElement(LineProtocol::ElementType::FieldKey, field.first) << "=";
+                appendEscaped(fields, field.first, commaEqualsAndSpace);
+                fields += '=';
                 std::visit(overloaded{
-                               [&convert](int v)
-                               { convert << v << 'i'; },
-                               [&convert](long long int v)
-                               { convert << v << 'i'; },
-                               [&convert](double v)
-                               { convert << v; },
-                               [&convert](const std::string& v)
-                               { convert << '"' << LineProtocol::EscapeStringElement(LineProtocol::ElementType::FieldValue, v) << '"'; },
-                               [&convert](bool v)
-                               { convert << (v ? "true" : "false"); },
-                               [&convert](unsigned int v)
-                               { convert << v << 'u'; },
-                               [&convert](unsigned long long int v)
-                               { convert << v << 'u'; },
+                               [&fields](int v)
+                               { appendFieldValue(fields, static_cast<long long int>(v)); },
+                               [&fields](long long int v)
+                               { appendFieldValue(fields, v); },
+                               [&fields](double v)
+                               { appendFieldValue(fields, v); },
+                               [&fields](const std::string& v)
+                               { appendFieldValue(fields, std::string_view{v}); },
+                               [&fields](bool v)
+                               { appendFieldValue(fields, v); },
+                               [&fields](unsigned int v)
+                               { appendFieldValue(fields, static_cast<unsigned long long int>(v)); },
+                               [&fields](unsigned long long int v)
+                               { appendFieldValue(fields, v); },
                            },
                            field.second);
-                addComma = true;
             }
 
-            return convert.str();
+            return fields;
         }
 
         template <class TimeUnit>
-        std::string toPrecision(std::chrono::time_point<std::chrono::system_clock> timestamp)
+        void appendTimestamp(std::string& line, std::chrono::time_point<std::chrono::system_clock> timestamp)
         {
-            return std::to_string(std::chrono::duration_cast<TimeUnit>(timestamp.time_since_epoch()).count());
+            appendNumber(line, static_cast<std::int64_t>(std::chrono::duration_cast<TimeUnit>(timestamp.time_since_epoch()).count()));
         }
 
-        std::string toTimestampString(TimePrecision precision, std::chrono::time_point<std::chrono::system_clock> timestamp)
+        auto timestampFormatterOf(TimePrecision precision)
         {
             switch (precision)
             {
                 case TimePrecision::Hours:
-                    return toPrecision<std::chrono::hours>(timestamp);
+                    return &appendTimestamp<std::chrono::hours>;
                 case TimePrecision::Minutes:
-                    return toPrecision<std::chrono::minutes>(timestamp);
+                    return &appendTimestamp<std::chrono::minutes>;
                 case TimePrecision::Seconds:
-                    return toPrecision<std::chrono::seconds>(timestamp);
+                    return &appendTimestamp<std::chrono::seconds>;
                 case TimePrecision::MilliSeconds:
-                    return toPrecision<std::chrono::milliseconds>(timestamp);
+                    return &appendTimestamp<std::chrono::milliseconds>;
                 case TimePrecision::MicroSeconds:
-                    return toPrecision<std::chrono::microseconds>(timestamp);
+                    return &appendTimestamp<std::chrono::microseconds>;
                 case TimePrecision::NanoSeconds:
                 default:
-                    return toPrecision<std::chrono::nanoseconds>(timestamp);
+                    return &appendTimestamp<std::chrono::nanoseconds>;
             }
         }
     }
 
-    LineProtocol::LineProtocol(const std::string& tags, TimePrecision precision)
-        : globalTags(tags), timePrecision(precision)
+    LineProtocol::LineProtocol(const std::string& tags, TimePrecision precision, bool sortTags)
+        : globalTags(tags), formatTimestamp(timestampFormatterOf(precision)), isSortingTags(sortTags), globalTagSet{}
+    {
+        if (sortTags)
+        {
+            globalTagSet = splitTags(globalTags);
+        }
+    }
+
+    LineWriter LineProtocol::writerOf(std::string& line) const
     {
+        return LineWriter{line, formatTimestamp, globalTags};
     }
 
     std::string LineProtocol::format(const Point& point) const
     {
-        std::string line{LineProtocol::EscapeStringElement(LineProtocol::ElementType::Measurement, point.getName())};
-        appendIfNotEmpty(line, globalTags, ',');
-        appendIfNotEmpty(line, formatTags(point.getTagSet()), ',');
+        std::string line;
+        formatTo(line, point);
+        return line;
+    }
+
+    void LineProtocol::formatTo(std::string& line, const Point& point) const
+    {
+        line.append(LineProtocol::EscapeStringElement(LineProtocol::ElementType::Measurement, point.getName()));
+        if (isSortingTags)
+        {
+            appendIfNotEmpty(line, formatSortedTags(point.getTagSet()), ',');
+        }
+        else
+        {
+            appendIfNotEmpty(line, globalTags, ',');
+            appendIfNotEmpty(line, formatTags(point.getTagSet()), ',');
+        }
         appendIfNotEmpty(line, formatFields(point.getFieldSet()), ' ');
 
-        return line.append(" ").append(toTimestampString(timePrecision, point.getTimestamp()));
+        if (point.hasTimestamp())
+        {
+            line.push_back(' ');
+            formatTimestamp(line, point.getTimestamp());
+        }
     }
 
-    std::string LineProtocol::EscapeStringElement(LineProtocol::ElementType type, std::string_view element)
+    std::string LineProtocol::formatSortedTags(const Point::TagSet& tags) const
     {
-        // https://docs.influxdata.com/influxdb/cloud/reference/syntax/line-protocol/#special-characters
-        static const std::string commaAndSpace{", "};
-        static const std::string commaEqualsAndSpace{",= "};
-        static const std::string doubleQuoteAndBackslash{R"("\)"};
+        auto tagSet = globalTagSet;
+        tagSet.reserve(tagSet.size() + tags.size());
+
+        for (const auto& [key, value] : tags)
+        {
+            tagSet.emplace_back(EscapeStringElement(ElementType::TagKey, key), EscapeStringElement(ElementType::TagValue, value));
+        }
+        std::stable_sort(tagSet.begin(), tagSet.end(), [](const auto& a, const auto& b)
+                         { return a.first < b.first; });
+
+        std::string formatted;
+        for (const auto& [key, value] : tagSet)
+        {
+            if (!formatted.empty())
+            {
+                formatted += ',';
+            }
+            formatted.append(key).append(1, '=').append(value);
+        }
+        return formatted;
+    }
 
+    std::string LineProtocol::EscapeStringElement(LineProtocol::ElementType type, std::string_view element)
+    {
         switch (type)
         {
             case ElementType::Measurement:
@@ -188,4 +332,135 @@ namespace influxdb
         }
         return std::string{element};
     }
+
+    LineWriter::LineWriter(std::string& line, TimePrecision precision, std::string_view globalTags)
+        : LineWriter(line, timestampFormatterOf(precision), globalTags)
+    {
+    }
+
+    LineWriter::LineWriter(std::string& line, TimestampFormatter formatTimestamp, std::string_view globalTags)
+        : line_(line), formatTimestamp_(formatTimestamp), globalTags_(globalTags), hasFields_(false)
+    {
+    }
+
+    void LineWriter::measurement(std::string_view escapedName)
+    {
+        line_.append(escapedName);
+
+        if (!globalTags_.empty())
+        {
+            line_.append(1, ',').append(globalTags_);
+        }
+    }
+
+    void LineWriter::measurement(Unescaped name)
+    {
+        appendEscaped(line_, name.value, commaAndSpace);
+
+        if (!globalTags_.empty())
+        {
+            line_.append(1, ',').append(globalTags_);
+        }
+    }
+
+    void LineWriter::tag(Unescaped key, std::string_view value)
+    {
+        if (!value.empty())
+        {
+            line_.push_back(',');
+            appendEscaped(line_, key.value, commaEqualsAndSpace);
+            line_.push_back('=');
+            appendEscaped(line_, value, commaEqualsAndSpace);
+        }
+    }
+
+    void LineWriter::tag(std::string_view escapedKey, std::string_view value)
+    {
+        if (!value.empty())
+        {
+            line_.append(1, ',').append(escapedKey).append(1, '=');
+            appendEscaped(line_, value, commaEqualsAndSpace);
+        }
+    }
+
+    void LineWriter::field(std::string_view escapedKey, long long int value)
+    {
+        fieldKey(escapedKey);
+        appendFieldValue(line_, value);
+    }
+
+    void LineWriter::field(std::string_view escapedKey, unsigned long long int value)
+    {
+        fieldKey(escapedKey);
+        appendFieldValue(line_, value);
+    }
+
+    void LineWriter::field(std::string_view escapedKey, double value)
+    {
+        fieldKey(escapedKey);
+        appendFieldValue(line_, value);
+    }
+
+    void LineWriter::field(std::string_view escapedKey, bool value)
+    {
+        fieldKey(escapedKey);
+        appendFieldValue(line_, value);
+    }
+
+    void LineWriter::field(std::string_view escapedKey, std::string_view value)
+    {
+        fieldKey(escapedKey);
+        appendFieldValue(line_, value);
+    }
+
+    void LineWriter::field(Unescaped key, long long int value)
+    {
+        fieldKey(key);
+        appendFieldValue(line_, value);
+    }
+
+    void LineWriter::field(Unescaped key, unsigned long long int value)
+    {
+        fieldKey(key);
+        appendFieldValue(line_, value);
+    }
+
+    void LineWriter::field(Unescaped key, double value)
+    {
+        fieldKey(key);
+        appendFieldValue(line_, value);
+    }
+
+    void LineWriter::field(Unescaped key, bool value)
+    {
+        fieldKey(key);
+        appendFieldValue(line_, value);
+    }
+
+    void LineWriter::field(Unescaped key, std::string_view value)
+    {
+        fieldKey(key);
+        appendFieldValue(line_, value);
+    }
+
+    void LineWriter::timestamp(TimePoint time)
+    {
+        line_.push_back(' ');
+        formatTimestamp_(line_, time);
+    }
+
+    void LineWriter::fieldKey(std::string_view escapedKey)
+    {
+        line_.push_back(hasFields_ ? ',' : ' ');
+        line_.append(escapedKey).append(1, '=');
+        hasFields_ = true;
+    }
+
+    void LineWriter::fieldKey(Unescaped key)
+    {
+        line_.push_back(hasFields_ ? ',' : ' ');
+        appendEscaped(line_, key.value, commaEqualsAndSpace);
+        line_.push_back('=');
+        hasFields_ = true;
+    }
 }
@@ -22,21 +22,33 @@
 
 #pragma once
 
+#include "InfluxDB/LineWriter.h"
 #include "InfluxDB/Point.h"
 #include "InfluxDB/TimePrecision.h"
 
+#include <chrono>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace influxdb
 {
     class LineProtocol
     {
     public:
-        // Caller must ensure that the tags string is correctly escaped
-        LineProtocol(const std::string& tags, TimePrecision precision);
+        // Caller must ensure that the tags string is correctly escaped; if
+        // sortTags is set, global and point tags are ordered by key
+        LineProtocol(const std::string& tags, TimePrecision precision, bool sortTags = false);
 
         std::string format(const Point& point) const;
 
+        // Appends the line of the point to the buffer
+        void formatTo(std::string& line, const Point& point) const;
+
+        // Writer appending to the buffer with the global tags and precision of
+        // this formatter (unsorted); the formatter must outlive it
+        LineWriter writerOf(std::string& line) const;
+
         enum class ElementType
         {
             Measurement,
@@ -52,7 +64,13 @@ namespace influxdb
         static std::string EscapeStringElement(ElementType type, std::string_view stringElement);
 
     private:
+        std::string formatSortedTags(const Point::TagSet& tags) const;
+
         std::string globalTags;
-        TimePrecision timePrecision;
+        // Resolved once for the precision
+        void (*formatTimestamp)(std::string&, std::chrono::time_point<std::chrono::system_clock>);
+        bool isSortingTags;
+        // Escaped key and value of the global tags, split only if sorting
+        std::vector<std::pair<std::string, std::string>> globalTagSet;
     };
 }
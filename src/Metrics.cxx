@@ -0,0 +1,88 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InfluxDB/Metrics.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <numeric>
+
+namespace influxdb
+{
+    LatencyHistogram::Buckets LatencyHistogram::snapshot() const noexcept
+    {
+        Buckets counts{};
+        std::transform(buckets_.cbegin(), buckets_.cend(), counts.begin(), [](const auto& bucket)
+                       { return bucket.load(std::memory_order_relaxed); });
+        return counts;
+    }
+
+    std::size_t LatencyHistogram::bucketOf(std::chrono::nanoseconds latency) noexcept
+    {
+        const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+
+        if (micros <= 0)
+        {
+            return 0;
+        }
+        return std::min<std::size_t>(static_cast<std::size_t>(std::bit_width(static_cast<std::uint64_t>(micros))), bucketCount - 1);
+    }
+
+    std::chrono::microseconds LatencyHistogram::quantile(const Buckets& buckets, double q) noexcept
+    {
+        const auto total = std::accumulate(buckets.cbegin(), buckets.cend(), std::uint64_t{0});
+
+        if (total == 0)
+        {
+            return std::chrono::microseconds{0};
+        }
+
+        const auto rank = std::max<std::uint64_t>(static_cast<std::uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * static_cast<double>(total))), 1);
+        std::uint64_t count{0};
+
+        for (std::size_t i = 0; i < buckets.size(); ++i)
+        {
+            count += buckets[i];
+
+            if (count >= rank)
+            {
+                return std::chrono::microseconds{std::uint64_t{1} << i};
+            }
+        }
+        return std::chrono::microseconds{std::uint64_t{1} << (bucketCount - 1)};
+    }
+
+    MetricsSnapshot Metrics::snapshot() const noexcept
+    {
+        MetricsSnapshot snapshot;
+        snapshot.pointsWritten = pointsWritten_.load(std::memory_order_relaxed);
+        snapshot.bytesSerialized = bytesSerialized_.load(std::memory_order_relaxed);
+        snapshot.batchesFlushed = batchesFlushed_.load(std::memory_order_relaxed);
+        snapshot.batchedPoints = batchedPoints_.load(std::memory_order_relaxed);
+        snapshot.transmits = transmits_.load(std::memory_order_relaxed);
+        snapshot.transmitErrors = transmitErrors_.load(std::memory_order_relaxed);
+        snapshot.pointsDropped = pointsDropped_.load(std::memory_order_relaxed);
+        snapshot.flushLatency = flushLatency_.snapshot();
+        snapshot.transmitLatency = transmitLatency_.snapshot();
+        return snapshot;
+    }
+}
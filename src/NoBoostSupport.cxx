@@ -26,7 +26,20 @@
 
 namespace influxdb::internal
 {
-    std::vector<Point> queryImpl([[maybe_unused]] Transport* transport, [[maybe_unused]] const std::string& query)
+    std::vector<std::vector<Point>> queryStatementsImpl([[maybe_unused]] Transport* transport, [[maybe_unused]] const std::string& query,
+                                                        [[maybe_unused]] std::optional<TimePrecision> epoch, [[maybe_unused]] WorkerPool* decodePool)
+    {
+        throw InfluxDBException("Query requires Boost");
+    }
+
+    std::vector<Point> queryImpl([[maybe_unused]] Transport* transport, [[maybe_unused]] const std::string& query,
+                                 [[maybe_unused]] std::optional<TimePrecision> epoch, [[maybe_unused]] WorkerPool* decodePool)
+    {
+        throw InfluxDBException("Query requires Boost");
+    }
+
+    void queryStreamImpl([[maybe_unused]] Transport* transport, [[maybe_unused]] const std::string& query, [[maybe_unused]] std::size_t chunkSize,
+                         [[maybe_unused]] std::optional<TimePrecision> epoch, [[maybe_unused]] const std::function<void(Point&&)>& onPoint)
     {
         throw InfluxDBException("Query requires Boost");
     }
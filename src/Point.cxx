@@ -26,7 +26,11 @@
 ///
 
 #include "InfluxDB/Point.h"
+#include "InfluxDB/CoarseClock.h"
+#include "PointClock.h"
+#include <atomic>
 #include <chrono>
+#include <memory>
 #include <sstream>
 #include <iomanip>
 
@@ -41,10 +45,32 @@ namespace influxdb
         };
         template <class... Ts>
         overloaded(Ts...) -> overloaded<Ts...>;
+
+        // Points hold a reference while reading the clock, so it stays alive if
+        // replaced concurrently; the flag spares the reference if there's none
+        std::atomic<std::shared_ptr<const CoarseClock>> clockSource{};
+        std::atomic<bool> hasClockSource{false};
+    }
+
+    Point::TimePoint internal::currentTime()
+    {
+        if (hasClockSource.load(std::memory_order_acquire))
+        {
+            if (const auto clock = clockSource.load(std::memory_order_acquire); clock != nullptr)
+            {
+                return clock->now();
+            }
+        }
+        return std::chrono::system_clock::now();
     }
 
     Point::Point(const std::string& measurement)
-        : mMeasurement(measurement), mTimestamp(std::chrono::system_clock::now()), mTags({}), mFields({})
+        : Point(measurement, internal::currentTime())
+    {
+    }
+
+    Point::Point(const std::string& measurement, std::optional<TimePoint> timestamp)
+        : mMeasurement(measurement), mTimestamp(timestamp), mTags({}), mFields({})
     {
     }
 
@@ -55,7 +81,7 @@ namespace influxdb
             return std::move(*this);
         }
 
-        mFields.emplace_back(std::make_pair(name, value));
+        mFields.emplace_back(name, value);
         return std::move(*this);
     }
 
@@ -66,7 +92,7 @@ namespace influxdb
             return std::move(*this);
         }
 
-        mTags.emplace_back(std::make_pair(key, value));
+        mTags.emplace_back(key, value);
         return std::move(*this);
     }
 
@@ -83,7 +109,12 @@ namespace influxdb
 
     std::chrono::time_point<std::chrono::system_clock> Point::getTimestamp() const
     {
-        return mTimestamp;
+        return mTimestamp.value_or(TimePoint{});
+    }
+
+    bool Point::hasTimestamp() const
+    {
+        return mTimestamp.has_value();
     }
 
     std::string Point::getFields() const
@@ -151,4 +182,11 @@ namespace influxdb
         return mTags;
     }
 
+    void Point::setClock(std::shared_ptr<const CoarseClock> clock)
+    {
+        const bool isSet{clock != nullptr};
+        clockSource.store(std::move(clock), std::memory_order_release);
+        hasClockSource.store(isSet, std::memory_order_release);
+    }
+
 } // namespace influxdb
@@ -0,0 +1,199 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InfluxDB/QueryCache.h"
+#include <cctype>
+
+namespace influxdb
+{
+    QueryCache::QueryCache(std::size_t maxBytes, std::chrono::milliseconds timeToLive)
+        : maxBytes_(maxBytes),
+          timeToLive_(timeToLive),
+          mutex_{},
+          entries_{},
+          index_{},
+          pending_{},
+          bytes_{0},
+          hits_{0},
+          misses_{0}
+    {
+    }
+
+    std::string QueryCache::get(const std::string& query, const std::function<std::string()>& execute)
+    {
+        std::unique_lock lock{mutex_};
+
+        if (const auto cached = index_.find(query); cached != index_.end())
+        {
+            if (cached->second->expiry > std::chrono::steady_clock::now())
+            {
+                ++hits_;
+                entries_.splice(entries_.begin(), entries_, cached->second);
+                return cached->second->response;
+            }
+            evict(cached->second);
+        }
+
+        if (const auto inFlight = pending_.find(query); inFlight != pending_.end())
+        {
+            ++hits_;
+            const auto response = inFlight->second;
+            lock.unlock();
+            return response.get();
+        }
+
+        ++misses_;
+        std::promise<std::string> promise;
+        pending_.emplace(query, promise.get_future().share());
+        lock.unlock();
+
+        try
+        {
+            auto response = execute();
+
+            lock.lock();
+            pending_.erase(query);
+            insert(query, response);
+            promise.set_value(response);
+            return response;
+        }
+        catch (...)
+        {
+            // Failures are passed to waiting requests, but never cached
+            lock.lock();
+            pending_.erase(query);
+            promise.set_exception(std::current_exception());
+            throw;
+        }
+    }
+
+    void QueryCache::clear()
+    {
+        std::lock_guard lock{mutex_};
+        entries_.clear();
+        index_.clear();
+        bytes_ = 0;
+    }
+
+    std::size_t QueryCache::hits() const
+    {
+        std::lock_guard lock{mutex_};
+        return hits_;
+    }
+
+    std::size_t QueryCache::misses() const
+    {
+        std::lock_guard lock{mutex_};
+        return misses_;
+    }
+
+    std::size_t QueryCache::bytes() const
+    {
+        std::lock_guard lock{mutex_};
+        return bytes_;
+    }
+
+    bool QueryCache::isCacheable(std::string_view query)
+    {
+        std::string statement;
+        bool hasInto{false};
+        bool isTerminated{false};
+
+        for (std::size_t i = 0; i < query.size(); ++i)
+        {
+            const auto c = static_cast<unsigned char>(query[i]);
+
+            if (std::isspace(c) != 0)
+            {
+                continue;
+            }
+            if (isTerminated || (statement.empty() && std::isalpha(c) == 0))
+            {
+                return false; // Further statement or no leading keyword
+            }
+
+            if (c == ';')
+            {
+                isTerminated = true;
+            }
+            else if (c == '\'' || c == '"')
+            {
+                // Strings and quoted identifiers may contain keywords and separators
+                const auto quote = query[i];
+                for (++i; i < query.size() && query[i] != quote; ++i)
+                {
+                    if (query[i] == '\\')
+                    {
+                        ++i; // Escaped character
+                    }
+                }
+            }
+            else if (std::isalnum(c) != 0 || c == '_')
+            {
+                std::string word;
+                for (; i < query.size() && (std::isalnum(static_cast<unsigned char>(query[i])) != 0 || query[i] == '_'); ++i)
+                {
+                    word += static_cast<char>(std::toupper(static_cast<unsigned char>(query[i])));
+                }
+                --i;
+
+                if (statement.empty())
+                {
+                    statement = std::move(word);
+                }
+                else if (word == "INTO")
+                {
+                    hasInto = true;
+                }
+            }
+        }
+        return (statement == "SELECT" && !hasInto) || statement == "SHOW";
+    }
+
+    void QueryCache::insert(const std::string& query, const std::string& response)
+    {
+        const auto size = query.size() + response.size();
+        if (size > maxBytes_ || timeToLive_.count() <= 0)
+        {
+            return;
+        }
+        if (const auto existing = index_.find(query); existing != index_.end())
+        {
+            evict(existing->second);
+        }
+        while (bytes_ + size > maxBytes_)
+        {
+            evict(std::prev(entries_.end()));
+        }
+
+        entries_.push_front(Entry{query, response, std::chrono::steady_clock::now() + timeToLive_});
+        index_.emplace(query, entries_.begin());
+        bytes_ += size;
+    }
+
+    void QueryCache::evict(std::list<Entry>::iterator entry)
+    {
+        bytes_ -= entry->query.size() + entry->response.size();
+        index_.erase(entry->query);
+        entries_.erase(entry);
+    }
+}
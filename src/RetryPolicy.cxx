@@ -0,0 +1,62 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InfluxDB/RetryPolicy.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace influxdb
+{
+    std::chrono::milliseconds RetryPolicy::backoff(std::size_t attempt) const
+    {
+        const auto exponent = static_cast<double>(std::max<std::size_t>(attempt, 1) - 1);
+        const auto scaled = static_cast<double>(initialBackoff.count()) * std::pow(multiplier, exponent);
+        const auto capped = std::min(scaled, static_cast<double>(maxBackoff.count()));
+        const auto delay = static_cast<std::chrono::milliseconds::rep>(std::max(capped, 0.0));
+
+        if (!jitter || delay == 0)
+        {
+            return std::chrono::milliseconds{delay};
+        }
+
+        thread_local std::mt19937_64 generator{std::random_device{}()};
+        std::uniform_int_distribution<std::chrono::milliseconds::rep> distribution{0, delay};
+        return std::chrono::milliseconds{distribution(generator)};
+    }
+
+    bool RetryPolicy::isRetryableStatus(long status)
+    {
+        switch (status)
+        {
+            case 408: // Request Timeout
+            case 429: // Too Many Requests
+            case 500: // Internal Server Error
+            case 502: // Bad Gateway
+            case 503: // Service Unavailable
+            case 504: // Gateway Timeout
+                return true;
+            default:
+                return false;
+        }
+    }
+}
@@ -0,0 +1,269 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InfluxDB/Router.h"
+#include <algorithm>
+#include <exception>
+#include <string>
+
+namespace influxdb::transports
+{
+    namespace
+    {
+        // 64 bit FNV-1a; the final mix spreads keys differing in the last
+        // characters only over the whole ring
+        std::uint64_t hashOf(std::string_view data)
+        {
+            std::uint64_t hash{14695981039346656037ULL};
+
+            for (const auto c : data)
+            {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= 1099511628211ULL;
+            }
+
+            hash ^= hash >> 33;
+            hash *= 0xff51afd7ed558ccdULL;
+            hash ^= hash >> 33;
+            hash *= 0xc4ceb9fe1a85ec53ULL;
+            hash ^= hash >> 33;
+            return hash;
+        }
+
+        // Measurement (and tags) up to the first unescaped delimiter
+        std::string_view keyOf(std::string_view line, bool withTags)
+        {
+            for (std::size_t i = 0; i < line.size(); ++i)
+            {
+                if (line[i] == '\\')
+                {
+                    ++i;
+                }
+                else if (line[i] == ' ' || (line[i] == ',' && !withTags))
+                {
+                    return line.substr(0, i);
+                }
+            }
+            return line;
+        }
+
+        std::vector<RouterBackend> namedByIndex(std::vector<std::unique_ptr<Transport>> transports)
+        {
+            std::vector<RouterBackend> backends;
+            backends.reserve(transports.size());
+
+            for (auto& transport : transports)
+            {
+                backends.push_back(RouterBackend{"backend-" + std::to_string(backends.size()), std::move(transport)});
+            }
+            return backends;
+        }
+
+        std::string messageOf(const std::exception_ptr& failure)
+        {
+            try
+            {
+                std::rethrow_exception(failure);
+            }
+            catch (const std::exception& e)
+            {
+                return e.what();
+            }
+            catch (...)
+            {
+                return "unknown error";
+            }
+        }
+
+        template <class Function>
+        void forEachBackend(std::vector<std::unique_ptr<Transport>>& backends, Function function)
+        {
+            for (auto& backend : backends)
+            {
+                function(*backend);
+            }
+        }
+    }
+
+    Router::Router(std::vector<RouterBackend> backends, RoutingStrategy strategy, std::size_t virtualNodes)
+        : backends_{}, strategy_(strategy), ring_{}, nextBackend_{0}
+    {
+        if (backends.empty())
+        {
+            throw InfluxDBException{"Router requires at least one backend"};
+        }
+
+        std::vector<std::string> names;
+        for (auto& backend : backends)
+        {
+            if (backend.transport == nullptr)
+            {
+                throw InfluxDBException{"Backend must not be nullptr"};
+            }
+            if (backend.name.empty() || std::find(names.cbegin(), names.cend(), backend.name) != names.cend())
+            {
+                throw InfluxDBException{"Backend names must be unique and not empty"};
+            }
+            names.push_back(backend.name);
+            backends_.push_back(std::move(backend.transport));
+        }
+
+        // Nodes are derived from the names only, so the nodes of other backends
+        // stay in place if one is added or removed
+        const auto nodes = std::max<std::size_t>(virtualNodes, 1);
+        ring_.reserve(backends_.size() * nodes);
+
+        for (std::size_t backend = 0; backend < backends_.size(); ++backend)
+        {
+            for (std::size_t node = 0; node < nodes; ++node)
+            {
+                ring_.emplace_back(hashOf(names[backend] + "#" + std::to_string(node)), backend);
+            }
+        }
+        std::sort(ring_.begin(), ring_.end());
+    }
+
+    Router::Router(std::vector<std::unique_ptr<Transport>> backends, RoutingStrategy strategy, std::size_t virtualNodes)
+        : Router(namedByIndex(std::move(backends)), strategy, virtualNodes)
+    {
+    }
+
+    void Router::send(std::string&& message)
+    {
+        std::vector<std::string> messages(backends_.size());
+        std::string_view lines{message};
+
+        while (!lines.empty())
+        {
+            const auto end = lines.find('\n');
+            const auto line = lines.substr(0, end);
+            lines.remove_prefix(end == std::string_view::npos ? lines.size() : end + 1);
+
+            if (line.empty())
+            {
+                continue;
+            }
+
+            std::size_t backend{0};
+
+            if (strategy_ == RoutingStrategy::RoundRobin)
+            {
+                backend = nextBackend_;
+                nextBackend_ = (nextBackend_ + 1) % backends_.size();
+            }
+            else
+            {
+                backend = backendOf(line);
+            }
+
+            auto& target = messages[backend];
+
+            if (!target.empty())
+            {
+                target += '\n';
+            }
+            target += line;
+        }
+
+        std::exception_ptr failure;
+        std::string undelivered;
+        bool isDelivered{false};
+
+        for (std::size_t backend = 0; backend < backends_.size(); ++backend)
+        {
+            if (messages[backend].empty())
+            {
+                continue;
+            }
+
+            try
+            {
+                backends_[backend]->send(std::string{messages[backend]});
+                isDelivered = true;
+            }
+            catch (...)
+            {
+                if (!failure)
+                {
+                    failure = std::current_exception();
+                }
+                if (!undelivered.empty())
+                {
+                    undelivered += '\n';
+                }
+                undelivered += messages[backend];
+            }
+        }
+
+        if (failure && !isDelivered)
+        {
+            std::rethrow_exception(failure);
+        }
+        if (failure)
+        {
+            // Sending the whole message again would duplicate the delivered points
+            throw PartialSendException{"Sending to some backends failed: " + messageOf(failure), std::move(undelivered)};
+        }
+    }
+
+    void Router::createDatabase()
+    {
+        forEachBackend(backends_, [](Transport& backend)
+                       { backend.createDatabase(); });
+    }
+
+    void Router::setProxy(const Proxy& proxy)
+    {
+        forEachBackend(backends_, [&proxy](Transport& backend)
+                       { backend.setProxy(proxy); });
+    }
+
+    void Router::setTimePrecision(TimePrecision precision)
+    {
+        forEachBackend(backends_, [precision](Transport& backend)
+                       { backend.setTimePrecision(precision); });
+    }
+
+    void Router::setQueryEpoch(TimePrecision epoch)
+    {
+        forEachBackend(backends_, [epoch](Transport& backend)
+                       { backend.setQueryEpoch(epoch); });
+    }
+
+    bool Router::ping()
+    {
+        return std::all_of(backends_.begin(), backends_.end(), [](auto& backend)
+                           { return backend->ping(); });
+    }
+
+    std::size_t Router::backendOf(std::string_view line) const
+    {
+        const auto hash = hashOf(keyOf(line, strategy_ != RoutingStrategy::MeasurementHash));
+        auto node = std::lower_bound(ring_.cbegin(), ring_.cend(), std::make_pair(hash, std::size_t{0}));
+
+        if (node == ring_.cend())
+        {
+            node = ring_.cbegin();
+        }
+        return node->second;
+    }
+}
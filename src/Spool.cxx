@@ -0,0 +1,530 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InfluxDB/Spool.h"
+#include "InfluxDB/InfluxDBException.h"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+namespace influxdb::transports
+{
+    namespace
+    {
+        // Record layout: payload length (u32 LE), CRC-32 of payload (u32 LE), payload
+        constexpr std::size_t recordHeaderSize{8};
+        constexpr const char* segmentExtension{".spool"};
+
+        // Replay position: sequence of the head segment (u64 LE), offset in it (u64 LE)
+        constexpr std::size_t cursorSize{16};
+        constexpr const char* cursorFileName{"replay.cursor"};
+
+        constexpr std::array<std::uint32_t, 256> makeCrcTable()
+        {
+            std::array<std::uint32_t, 256> table{};
+            for (std::uint32_t i = 0; i < table.size(); ++i)
+            {
+                std::uint32_t crc{i};
+                for (int bit = 0; bit < 8; ++bit)
+                {
+                    crc = (crc & 1u) != 0 ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+                }
+                table[i] = crc;
+            }
+            return table;
+        }
+
+        std::uint32_t crc32(std::string_view data)
+        {
+            static constexpr auto table = makeCrcTable();
+            std::uint32_t crc{0xFFFFFFFFu};
+            for (const auto c : data)
+            {
+                crc = table[(crc ^ static_cast<std::uint8_t>(c)) & 0xFFu] ^ (crc >> 8);
+            }
+            return crc ^ 0xFFFFFFFFu;
+        }
+
+        void writeUint32(char* dest, std::uint32_t value)
+        {
+            for (std::size_t i = 0; i < 4; ++i)
+            {
+                dest[i] = static_cast<char>((value >> (8 * i)) & 0xFFu);
+            }
+        }
+
+        std::uint32_t readUint32(const char* src)
+        {
+            std::uint32_t value{0};
+            for (std::size_t i = 0; i < 4; ++i)
+            {
+                value |= static_cast<std::uint32_t>(static_cast<std::uint8_t>(src[i])) << (8 * i);
+            }
+            return value;
+        }
+
+        void writeUint64(char* dest, std::uint64_t value)
+        {
+            writeUint32(dest, static_cast<std::uint32_t>(value & 0xFFFFFFFFu));
+            writeUint32(dest + 4, static_cast<std::uint32_t>(value >> 32));
+        }
+
+        std::uint64_t readUint64(const char* src)
+        {
+            return static_cast<std::uint64_t>(readUint32(src)) | (static_cast<std::uint64_t>(readUint32(src + 4)) << 32);
+        }
+
+        std::filesystem::path segmentPath(const std::filesystem::path& directory, std::uint64_t sequence)
+        {
+            std::ostringstream name;
+            name << std::setw(20) << std::setfill('0') << sequence << segmentExtension;
+            return directory / name.str();
+        }
+    }
+
+
+    Spool::Spool(std::unique_ptr<Transport> transport, const std::filesystem::path& directory, SpoolOptions options)
+        : transport_(std::move(transport)),
+          transportMutex_{},
+          directory_(directory),
+          options_(options),
+          mutex_{},
+          condition_{},
+          segments_{},
+          writer_{},
+          reader_{},
+          readerSequence_{0},
+          cursor_{},
+          readOffset_{0},
+          totalBytes_{0},
+          evictedBytes_{0},
+          rejections_{0},
+          nextSequence_{0},
+          stop_{false},
+          replayThread_{}
+    {
+        if (transport_ == nullptr)
+        {
+            throw InfluxDBException{"Transport must not be nullptr"};
+        }
+
+        std::error_code error;
+        std::filesystem::create_directories(directory_, error);
+        if (error)
+        {
+            throw InfluxDBException{"Unable to create spool directory: " + error.message()};
+        }
+
+        // Recover segments of a previous run, ordered by their sequence number
+        for (const auto& entry : std::filesystem::directory_iterator{directory_})
+        {
+            const auto name = entry.path().stem().string();
+            std::uint64_t sequence{0};
+
+            if (entry.is_regular_file() && entry.path().extension() == segmentExtension && std::from_chars(name.data(), name.data() + name.size(), sequence).ec == std::errc{})
+            {
+                segments_.push_back(Segment{sequence, entry.path(), static_cast<std::size_t>(entry.file_size())});
+            }
+        }
+        std::sort(segments_.begin(), segments_.end(), [](const auto& a, const auto& b)
+                  { return a.sequence < b.sequence; });
+
+        for (const auto& segment : segments_)
+        {
+            totalBytes_ += segment.size;
+        }
+        nextSequence_ = segments_.empty() ? 0 : segments_.back().sequence + 1;
+        loadCursor();
+
+        replayThread_ = std::thread{&Spool::replay, this};
+    }
+
+    Spool::~Spool()
+    {
+        {
+            std::lock_guard lock{mutex_};
+            stop_ = true;
+        }
+        condition_.notify_all();
+        replayThread_.join();
+    }
+
+    void Spool::send(std::string&& message)
+    {
+        {
+            std::lock_guard lock{mutex_};
+            if (pending() > 0)
+            {
+                append(message);
+                return;
+            }
+        }
+
+        try
+        {
+            std::lock_guard transportLock{transportMutex_};
+            transport_->send(std::string{message});
+        }
+        catch (const PartialSendException& e)
+        {
+            std::lock_guard lock{mutex_};
+            append(e.undelivered());
+        }
+        catch (const InfluxDBException&)
+        {
+            std::lock_guard lock{mutex_};
+            append(message);
+        }
+    }
+
+    std::string Spool::query(const std::string& query)
+    {
+        std::lock_guard transportLock{transportMutex_};
+        return transport_->query(query);
+    }
+
+    void Spool::queryChunked(const std::string& query, std::size_t chunkSize, const std::function<void(std::string_view)>& onChunk)
+    {
+        std::lock_guard transportLock{transportMutex_};
+        transport_->queryChunked(query, chunkSize, onChunk);
+    }
+
+    std::string Spool::queryArrow(const std::string& query)
+    {
+        std::lock_guard transportLock{transportMutex_};
+        return transport_->queryArrow(query);
+    }
+
+    std::string Spool::execute(const std::string& cmd)
+    {
+        std::lock_guard transportLock{transportMutex_};
+        return transport_->execute(cmd);
+    }
+
+    void Spool::createDatabase()
+    {
+        std::lock_guard transportLock{transportMutex_};
+        transport_->createDatabase();
+    }
+
+    void Spool::setProxy(const Proxy& proxy)
+    {
+        std::lock_guard transportLock{transportMutex_};
+        transport_->setProxy(proxy);
+    }
+
+    void Spool::setTimePrecision(TimePrecision precision)
+    {
+        std::lock_guard transportLock{transportMutex_};
+        transport_->setTimePrecision(precision);
+    }
+
+    void Spool::setQueryEpoch(TimePrecision epoch)
+    {
+        std::lock_guard transportLock{transportMutex_};
+        transport_->setQueryEpoch(epoch);
+    }
+
+    bool Spool::ping()
+    {
+        std::lock_guard transportLock{transportMutex_};
+        return transport_->ping();
+    }
+
+    std::size_t Spool::pendingBytes() const
+    {
+        std::lock_guard lock{mutex_};
+        return pending();
+    }
+
+    std::size_t Spool::evictedBytes() const
+    {
+        std::lock_guard lock{mutex_};
+        return evictedBytes_;
+    }
+
+    std::size_t Spool::pending() const
+    {
+        return totalBytes_ - readOffset_;
+    }
+
+    void Spool::append(const std::string& message)
+    {
+        const auto recordSize = recordHeaderSize + message.size();
+        if (recordSize > options_.maxBytes)
+        {
+            evictedBytes_ += recordSize;
+            return;
+        }
+        while (!segments_.empty() && totalBytes_ + recordSize > options_.maxBytes)
+        {
+            evictOldestSegment();
+        }
+        if (segments_.empty() || !writer_.is_open() || segments_.back().size >= options_.segmentBytes)
+        {
+            startSegment();
+        }
+
+        std::array<char, recordHeaderSize> header{};
+        writeUint32(header.data(), static_cast<std::uint32_t>(message.size()));
+        writeUint32(header.data() + 4, crc32(message));
+        writer_.write(header.data(), header.size());
+        writer_.write(message.data(), static_cast<std::streamsize>(message.size()));
+        writer_.flush();
+
+        if (!writer_)
+        {
+            throw InfluxDBException{"Unable to write spool segment " + segments_.back().path.string()};
+        }
+
+        segments_.back().size += recordSize;
+        totalBytes_ += recordSize;
+        condition_.notify_one();
+    }
+
+    void Spool::startSegment()
+    {
+        writer_.close();
+        writer_.clear();
+
+        Segment segment{nextSequence_++, {}, 0};
+        segment.path = segmentPath(directory_, segment.sequence);
+        writer_.open(segment.path, std::ios::binary | std::ios::trunc);
+
+        if (!writer_)
+        {
+            throw InfluxDBException{"Unable to create spool segment " + segment.path.string()};
+        }
+        segments_.push_back(std::move(segment));
+    }
+
+    void Spool::evictOldestSegment()
+    {
+        evictedBytes_ += segments_.front().size - readOffset_;
+        removeHeadSegment();
+    }
+
+    void Spool::removeHeadSegment()
+    {
+        if (segments_.size() == 1)
+        {
+            writer_.close();
+        }
+        reader_.close();
+
+        std::error_code ignored;
+        std::filesystem::remove(segments_.front().path, ignored);
+        totalBytes_ -= segments_.front().size;
+        segments_.pop_front();
+        readOffset_ = 0;
+        rejections_ = 0;
+    }
+
+    std::optional<std::string> Spool::readRecord(std::size_t& recordSize)
+    {
+        const auto& head = segments_.front();
+
+        // The head segment is read sequentially by one stream; it's only
+        // repositioned to read a record again (eg. after a failed send)
+        if (!reader_.is_open() || readerSequence_ != head.sequence)
+        {
+            reader_.close();
+            reader_.open(head.path, std::ios::binary);
+            readerSequence_ = head.sequence;
+        }
+        reader_.clear();
+
+        const std::streampos position{static_cast<std::streamoff>(readOffset_)};
+        if (reader_.tellg() != position)
+        {
+            reader_.seekg(position);
+        }
+
+        std::array<char, recordHeaderSize> header{};
+        if (!reader_.read(header.data(), header.size()))
+        {
+            return std::nullopt;
+        }
+
+        const auto length = readUint32(header.data());
+        if (readOffset_ + recordHeaderSize + length > head.size)
+        {
+            return std::nullopt;
+        }
+
+        std::string message(length, '\0');
+        if (!reader_.read(message.data(), static_cast<std::streamsize>(length)) || crc32(message) != readUint32(header.data() + 4))
+        {
+            return std::nullopt;
+        }
+
+        recordSize = recordHeaderSize + length;
+        return message;
+    }
+
+    void Spool::loadCursor()
+    {
+        const auto path = directory_ / cursorFileName;
+
+        if (std::ifstream in{path, std::ios::binary}; in)
+        {
+            std::array<char, cursorSize> cursor{};
+
+            // Applies only to the segment it was saved for, other segments start at 0
+            if (in.read(cursor.data(), cursor.size()) && !segments_.empty() && readUint64(cursor.data()) == segments_.front().sequence)
+            {
+                readOffset_ = std::min(static_cast<std::size_t>(readUint64(cursor.data() + 8)), segments_.front().size);
+            }
+        }
+
+        cursor_.open(path, std::ios::binary | std::ios::trunc);
+        saveCursor();
+    }
+
+    void Spool::saveCursor()
+    {
+        std::array<char, cursorSize> cursor{};
+        writeUint64(cursor.data(), segments_.empty() ? nextSequence_ : segments_.front().sequence);
+        writeUint64(cursor.data() + 8, readOffset_);
+
+        // Not fatal, a restart then replays the head segment from the start
+        cursor_.clear();
+        cursor_.seekp(0);
+        cursor_.write(cursor.data(), cursor.size());
+        cursor_.flush();
+    }
+
+    bool Spool::isReachable()
+    {
+        try
+        {
+            std::lock_guard transportLock{transportMutex_};
+            return transport_->ping();
+        }
+        catch (const InfluxDBException&)
+        {
+            return false;
+        }
+    }
+
+    void Spool::replay()
+    {
+        std::unique_lock lock{mutex_};
+
+        while (!stop_)
+        {
+            if (pending() == 0)
+            {
+                condition_.wait(lock, [this]
+                                { return stop_ || pending() > 0; });
+                continue;
+            }
+
+            if (readOffset_ >= segments_.front().size)
+            {
+                removeHeadSegment();
+                continue;
+            }
+
+            std::size_t recordSize{0};
+            auto message = readRecord(recordSize);
+            if (!message)
+            {
+                // Truncated or corrupted record (eg. after a crash), skip the rest of the segment
+                evictedBytes_ += segments_.front().size - readOffset_;
+                readOffset_ = segments_.front().size;
+                continue;
+            }
+
+            const auto sequence = segments_.front().sequence;
+            lock.unlock();
+
+            std::optional<std::string> error;
+            std::optional<std::string> undelivered;
+            try
+            {
+                std::lock_guard transportLock{transportMutex_};
+                transport_->send(std::string{*message});
+            }
+            catch (const PartialSendException& e)
+            {
+                undelivered = e.undelivered();
+            }
+            catch (const InfluxDBException& e)
+            {
+                error = e.what();
+            }
+            const bool rejected = error && isReachable();
+
+            lock.lock();
+            // The segment may have been evicted while sending
+            if (segments_.empty() || segments_.front().sequence != sequence)
+            {
+                continue;
+            }
+
+            if (error)
+            {
+                if (!rejected || ++rejections_ < options_.maxRejections)
+                {
+                    condition_.wait_for(lock, options_.retryInterval, [this]
+                                        { return stop_; });
+                    continue;
+                }
+                // Rejected by a reachable server, dropped to not block the following messages
+                evictedBytes_ += recordSize;
+            }
+
+            readOffset_ += recordSize;
+            rejections_ = 0;
+            if (readOffset_ >= segments_.front().size)
+            {
+                // Replayed segments are removed so a restart doesn't send them again
+                removeHeadSegment();
+            }
+            saveCursor();
+
+            if (undelivered)
+            {
+                // Only the undelivered part is retried, after the pending messages
+                try
+                {
+                    append(*undelivered);
+                }
+                catch (const InfluxDBException&)
+                {
+                    evictedBytes_ += recordHeaderSize + undelivered->size();
+                }
+            }
+
+            if (error && options_.onRejected)
+            {
+                lock.unlock();
+                options_.onRejected(*message, *error);
+                lock.lock();
+            }
+        }
+    }
+}
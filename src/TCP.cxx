@@ -63,12 +63,12 @@ namespace influxdb::transports
             const size_t written = mSocket.write_some(boost::asio::buffer(message, message.size()));
             if (written != message.size())
             {
-                throw InfluxDBException("Error while transmitting data");
+                throw ConnectionException("Error while transmitting data");
             }
         }
         catch (const boost::system::system_error& e)
         {
-            throw InfluxDBException(e.what());
+            throw ConnectionException(e.what());
         }
     }
 
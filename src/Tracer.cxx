@@ -0,0 +1,93 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InfluxDB/Tracer.h"
+#include "InfluxDB/InfluxDBException.h"
+#include <atomic>
+#include <cstdint>
+
+namespace influxdb
+{
+    namespace
+    {
+        // Small sequential ids are easier to read in trace viewers than hashed thread ids
+        std::uint64_t currentThreadId()
+        {
+            static std::atomic<std::uint64_t> nextId{1};
+            thread_local const auto id = nextId.fetch_add(1, std::memory_order_relaxed);
+            return id;
+        }
+    }
+
+    std::string_view toString(TraceSpan span)
+    {
+        switch (span)
+        {
+            case TraceSpan::Serialize:
+                return "serialize";
+            case TraceSpan::Send:
+                return "send";
+            case TraceSpan::Query:
+                return "query";
+            case TraceSpan::Decode:
+                return "decode";
+        }
+        return "unknown";
+    }
+
+    ChromeTraceWriter::ChromeTraceWriter(const std::string& path)
+        : out_(path, std::ios::trunc), start_(std::chrono::steady_clock::now()), firstEvent_(true)
+    {
+        if (!out_)
+        {
+            throw InfluxDBException{"Can't open trace file: " + path};
+        }
+        out_ << R"({"traceEvents":[)";
+    }
+
+    ChromeTraceWriter::~ChromeTraceWriter()
+    {
+        out_ << "\n]}\n";
+    }
+
+    void ChromeTraceWriter::begin(TraceSpan span)
+    {
+        writeEvent(span, 'B');
+    }
+
+    void ChromeTraceWriter::end(TraceSpan span)
+    {
+        writeEvent(span, 'E');
+    }
+
+    void ChromeTraceWriter::writeEvent(TraceSpan span, char phase)
+    {
+        const auto timestamp = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start_).count();
+        const auto threadId = currentThreadId();
+
+        std::lock_guard lock{mutex_};
+        out_ << (firstEvent_ ? "\n" : ",\n")
+             << R"({"name":")" << toString(span) << R"(","cat":"influxdb","ph":")" << phase
+             << R"(","ts":)" << std::fixed << timestamp << R"(,"pid":1,"tid":)" << threadId << '}';
+        firstEvent_ = false;
+    }
+}
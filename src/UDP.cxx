@@ -52,7 +52,7 @@ namespace influxdb::transports
         }
         catch (const boost::system::system_error& e)
         {
-            throw InfluxDBException(e.what());
+            throw ConnectionException(e.what());
         }
     }
 
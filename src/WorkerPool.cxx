@@ -0,0 +1,115 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "WorkerPool.h"
+#include <algorithm>
+#include <utility>
+
+namespace influxdb::internal
+{
+    WorkerPool::WorkerPool(std::size_t threads)
+        : runMutex_{}, mutex_{}, wake_{}, done_{}, task_{nullptr}, pending_{0}, running_{0}, error_{}, stop_{false}, threads_{}
+    {
+        threads_.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i)
+        {
+            threads_.emplace_back(&WorkerPool::work, this);
+        }
+    }
+
+    WorkerPool::~WorkerPool()
+    {
+        {
+            std::lock_guard lock{mutex_};
+            stop_ = true;
+        }
+        wake_.notify_all();
+
+        for (auto& thread : threads_)
+        {
+            thread.join();
+        }
+    }
+
+    std::size_t WorkerPool::size() const
+    {
+        return threads_.size();
+    }
+
+    void WorkerPool::run(std::size_t workers, const std::function<void()>& task)
+    {
+        std::lock_guard runLock{runMutex_};
+        std::unique_lock lock{mutex_};
+
+        task_ = &task;
+        pending_ = std::min(workers, threads_.size());
+        wake_.notify_all();
+        done_.wait(lock, [this]
+                   { return pending_ == 0 && running_ == 0; });
+        task_ = nullptr;
+
+        if (error_)
+        {
+            std::rethrow_exception(std::exchange(error_, nullptr));
+        }
+    }
+
+    void WorkerPool::work()
+    {
+        std::unique_lock lock{mutex_};
+
+        while (true)
+        {
+            wake_.wait(lock, [this]
+                       { return stop_ || pending_ > 0; });
+            if (stop_)
+            {
+                return;
+            }
+
+            --pending_;
+            ++running_;
+            const auto* task = task_;
+            lock.unlock();
+
+            std::exception_ptr error;
+            try
+            {
+                (*task)();
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            lock.lock();
+            if (error && !error_)
+            {
+                error_ = error;
+            }
+            if (--running_ == 0 && pending_ == 0)
+            {
+                done_.notify_all();
+            }
+        }
+    }
+}
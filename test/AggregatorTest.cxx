@@ -0,0 +1,194 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InfluxDB/Aggregator.h"
+#include "InfluxDB/InfluxDBException.h"
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+
+namespace influxdb::test
+{
+    namespace
+    {
+        using namespace std::chrono_literals;
+
+        std::chrono::time_point<std::chrono::system_clock> at(std::chrono::milliseconds offset)
+        {
+            return std::chrono::time_point<std::chrono::system_clock>{1000s + offset};
+        }
+
+        Point::FieldValue fieldOf(const Point& point, std::string_view name)
+        {
+            const auto& fields = point.getFieldSet();
+            const auto itr = std::find_if(fields.cbegin(), fields.cend(), [name](const auto& field)
+                                          { return field.first == name; });
+            REQUIRE(itr != fields.cend());
+            return itr->second;
+        }
+    }
+
+
+    TEST_CASE("Aggregation names", "[AggregatorTest]")
+    {
+        CHECK(toString(Aggregation::Sum) == "sum");
+        CHECK(toString(Aggregation::Min) == "min");
+        CHECK(toString(Aggregation::Max) == "max");
+        CHECK(toString(Aggregation::Count) == "count");
+        CHECK(toString(Aggregation::Last) == "last");
+        CHECK(toString(Aggregation::Mean) == "mean");
+    }
+
+    TEST_CASE("Constructor throws on invalid arguments", "[AggregatorTest]")
+    {
+        CHECK_THROWS_AS(Aggregator(0ms, {Aggregation::Sum}), InfluxDBException);
+        CHECK_THROWS_AS(Aggregator(1s, {}), InfluxDBException);
+    }
+
+    TEST_CASE("Points within a window are not emitted", "[AggregatorTest]")
+    {
+        Aggregator aggregator{1s, {Aggregation::Sum}};
+
+        CHECK(aggregator.add(Point{"m"}.addField("x", 1).setTimestamp(at(0ms))).empty());
+        CHECK(aggregator.add(Point{"m"}.addField("x", 2).setTimestamp(at(999ms))).empty());
+        CHECK(aggregator.activeSeries() == 1);
+    }
+
+    TEST_CASE("Window is emitted with all aggregations", "[AggregatorTest]")
+    {
+        Aggregator aggregator{1s, {Aggregation::Sum, Aggregation::Min, Aggregation::Max, Aggregation::Count, Aggregation::Last, Aggregation::Mean}};
+        aggregator.add(Point{"m"}.addTag("host", "a").addField("x", 3).setTimestamp(at(100ms)));
+        aggregator.add(Point{"m"}.addTag("host", "a").addField("x", 1.5).setTimestamp(at(200ms)));
+        aggregator.add(Point{"m"}.addTag("host", "a").addField("x", 4).setTimestamp(at(300ms)));
+
+        const auto points = aggregator.add(Point{"m"}.addTag("host", "a").addField("x", 7).setTimestamp(at(1200ms)));
+        REQUIRE(points.size() == 1);
+
+        const auto& point = points.front();
+        CHECK(point.getName() == "m");
+        CHECK(point.getTags() == "host=a");
+        CHECK(point.getTimestamp() == at(0ms));
+        CHECK(fieldOf(point, "x_sum") == Point::FieldValue{8.5});
+        CHECK(fieldOf(point, "x_min") == Point::FieldValue{1.5});
+        CHECK(fieldOf(point, "x_max") == Point::FieldValue{4.0});
+        CHECK(fieldOf(point, "x_count") == Point::FieldValue{3LL});
+        CHECK(fieldOf(point, "x_last") == Point::FieldValue{4});
+        CHECK(fieldOf(point, "x_mean") == Point::FieldValue{8.5 / 3});
+        CHECK(aggregator.activeSeries() == 1);
+    }
+
+    TEST_CASE("Series are aggregated separately", "[AggregatorTest]")
+    {
+        Aggregator aggregator{1s, {Aggregation::Sum}};
+        aggregator.add(Point{"m"}.addTag("host", "a").addField("x", 1).setTimestamp(at(0ms)));
+        aggregator.add(Point{"m"}.addTag("host", "b").addField("x", 2).setTimestamp(at(0ms)));
+        aggregator.add(Point{"n"}.addTag("host", "a").addField("x", 3).setTimestamp(at(0ms)));
+        CHECK(aggregator.activeSeries() == 3);
+
+        auto points = aggregator.flush();
+        REQUIRE(points.size() == 3);
+        std::sort(points.begin(), points.end(), [](const auto& a, const auto& b)
+                  { return a.getName() + a.getTags() < b.getName() + b.getTags(); });
+        CHECK(fieldOf(points[0], "x_sum") == Point::FieldValue{1.0});
+        CHECK(fieldOf(points[1], "x_sum") == Point::FieldValue{2.0});
+        CHECK(fieldOf(points[2], "x_sum") == Point::FieldValue{3.0});
+        CHECK(aggregator.activeSeries() == 0);
+    }
+
+    TEST_CASE("Series key does not depend on tag order", "[AggregatorTest]")
+    {
+        Aggregator aggregator{1s, {Aggregation::Count}};
+        aggregator.add(Point{"m"}.addTag("a", "1").addTag("b", "2").addField("x", 1).setTimestamp(at(0ms)));
+        aggregator.add(Point{"m"}.addTag("b", "2").addTag("a", "1").addField("x", 1).setTimestamp(at(0ms)));
+
+        CHECK(aggregator.activeSeries() == 1);
+    }
+
+    TEST_CASE("Later window completes idle series", "[AggregatorTest]")
+    {
+        Aggregator aggregator{1s, {Aggregation::Count}};
+        aggregator.add(Point{"m"}.addTag("host", "a").addField("x", 1).setTimestamp(at(0ms)));
+        aggregator.add(Point{"m"}.addTag("host", "b").addField("x", 1).setTimestamp(at(0ms)));
+
+        const auto points = aggregator.add(Point{"m"}.addTag("host", "c").addField("x", 1).setTimestamp(at(1000ms)));
+        CHECK(points.size() == 2);
+        CHECK(aggregator.activeSeries() == 1);
+    }
+
+    TEST_CASE("Series are distinguished by tag key and value", "[AggregatorTest]")
+    {
+        Aggregator aggregator{1s, {Aggregation::Count}};
+        aggregator.add(Point{"m"}.addTag("x=y", "z").addField("v", 1).setTimestamp(at(0ms)));
+        aggregator.add(Point{"m"}.addTag("x", "y=z").addField("v", 1).setTimestamp(at(0ms)));
+
+        CHECK(aggregator.activeSeries() == 2);
+    }
+
+    TEST_CASE("Late points are passed through", "[AggregatorTest]")
+    {
+        Aggregator aggregator{1s, {Aggregation::Sum}};
+        aggregator.add(Point{"m"}.addField("x", 1).setTimestamp(at(1000ms)));
+
+        const auto points = aggregator.add(Point{"m"}.addField("x", 5).setTimestamp(at(0ms)));
+        REQUIRE(points.size() == 1);
+        CHECK(points.front().getTimestamp() == at(0ms));
+        CHECK(fieldOf(points.front(), "x") == Point::FieldValue{5});
+    }
+
+    TEST_CASE("Late points of window completed by other series are passed through", "[AggregatorTest]")
+    {
+        Aggregator aggregator{1s, {Aggregation::Count}};
+        aggregator.add(Point{"a"}.addField("x", 1).setTimestamp(at(0ms)));
+        aggregator.add(Point{"a"}.addField("x", 2).setTimestamp(at(100ms)));
+
+        const auto completed = aggregator.add(Point{"b"}.addField("x", 3).setTimestamp(at(1000ms)));
+        REQUIRE(completed.size() == 1);
+        CHECK(fieldOf(completed.front(), "x_count") == Point::FieldValue{2LL});
+
+        const auto late = aggregator.add(Point{"a"}.addField("x", 5).setTimestamp(at(200ms)));
+        REQUIRE(late.size() == 1);
+        CHECK(late.front().getTimestamp() == at(200ms));
+        CHECK(fieldOf(late.front(), "x") == Point::FieldValue{5});
+        CHECK(aggregator.activeSeries() == 1);
+    }
+
+    TEST_CASE("Non numeric fields keep last value", "[AggregatorTest]")
+    {
+        Aggregator aggregator{1s, {Aggregation::Sum}};
+        aggregator.add(Point{"m"}.addField("state", "up").addField("ok", true).setTimestamp(at(0ms)));
+        aggregator.add(Point{"m"}.addField("state", "down").addField("ok", false).setTimestamp(at(10ms)));
+
+        const auto points = aggregator.flush();
+        REQUIRE(points.size() == 1);
+        CHECK(fieldOf(points.front(), "state") == Point::FieldValue{std::string{"down"}});
+        CHECK(fieldOf(points.front(), "ok") == Point::FieldValue{false});
+    }
+
+    TEST_CASE("Windows before epoch are aligned", "[AggregatorTest]")
+    {
+        Aggregator aggregator{1s, {Aggregation::Count}};
+        aggregator.add(Point{"m"}.addField("x", 1).setTimestamp(std::chrono::time_point<std::chrono::system_clock>{-1500ms}));
+
+        const auto points = aggregator.flush();
+        REQUIRE(points.size() == 1);
+        CHECK(points.front().getTimestamp() == std::chrono::time_point<std::chrono::system_clock>{-2000ms});
+    }
+}
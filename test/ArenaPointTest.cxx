@@ -0,0 +1,150 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InfluxDB/ArenaPoint.h"
+#include <memory_resource>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+
+namespace influxdb::test
+{
+    using namespace Catch::Matchers;
+
+    namespace
+    {
+        class CountingResource : public std::pmr::memory_resource
+        {
+        public:
+            std::size_t allocations{0};
+
+        private:
+            void* do_allocate(std::size_t bytes, std::size_t alignment) override
+            {
+                ++allocations;
+                return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+            }
+
+            void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+            {
+                std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+            }
+
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+            {
+                return this == &other;
+            }
+        };
+
+        const ArenaPoint::TimePoint ignoreTimestamp{std::chrono::milliseconds{4567}};
+
+        std::string lineOf(const ArenaPoint& point, std::string_view globalTags = {})
+        {
+            std::string line;
+            LineWriter writer{line, TimePrecision::NanoSeconds, globalTags};
+            point.formatTo(writer);
+            return line;
+        }
+    }
+
+    TEST_CASE("Arena point allocates from memory resource", "[ArenaPointTest]")
+    {
+        CountingResource resource;
+        const auto point = ArenaPoint{"a_measurement_name_beyond_small_string_size", &resource}
+                               .addTag("a_tag_key_beyond_small_string_size", "a_tag_value_beyond_small_string_size")
+                               .addField("a_field_name_beyond_small_string_size", "a_field_value_beyond_small_string_size");
+
+        CHECK(resource.allocations >= 6);
+        CHECK(point.getResource() == &resource);
+        CHECK(point.getFieldSet().get_allocator().resource() == &resource);
+        CHECK_THAT(std::string{point.getName()}, Equals("a_measurement_name_beyond_small_string_size"));
+    }
+
+    TEST_CASE("Arena point moved keeps memory resource", "[ArenaPointTest]")
+    {
+        CountingResource resource;
+        auto point = ArenaPoint{"p", &resource}.addTag("k", "v");
+        const ArenaPoint moved{std::move(point)};
+
+        CHECK(moved.getResource() == &resource);
+    }
+
+    TEST_CASE("Arena point copy uses default memory resource", "[ArenaPointTest]")
+    {
+        CountingResource resource;
+        const auto point = ArenaPoint{"p", &resource}.addTag("k", "v");
+        const ArenaPoint copy{point};
+
+        CHECK(copy.getResource() == std::pmr::get_default_resource());
+        CHECK(copy.getTagSet().size() == 1);
+    }
+
+    TEST_CASE("Arena point is time stamped by default", "[ArenaPointTest]")
+    {
+        const auto before = std::chrono::system_clock::now();
+        std::pmr::monotonic_buffer_resource arena;
+        const ArenaPoint point{"test", &arena};
+
+        CHECK(point.hasTimestamp());
+        CHECK(point.getTimestamp() >= before);
+        CHECK_FALSE(ArenaPoint("test", std::nullopt, &arena).hasTimestamp());
+    }
+
+    TEST_CASE("Arena point formats as point", "[ArenaPointTest]")
+    {
+        std::pmr::monotonic_buffer_resource arena;
+        const auto point = ArenaPoint{"cpu", ignoreTimestamp, &arena}
+                               .addTag("host", "host-1")
+                               .addTag("empty", "")
+                               .addField("usage", 0.5)
+                               .addField("procs", 12)
+                               .addField("id", 7u)
+                               .addField("up", true)
+                               .addField("state", "ok");
+
+        CHECK_THAT(lineOf(point, "g=0"), Equals("cpu,g=0,host=host-1 usage=0.500000000000000000,procs=12i,id=7u,up=true,state=\"ok\" 4567000000"));
+    }
+
+    TEST_CASE("Arena point escapes keys and values", "[ArenaPointTest]")
+    {
+        std::pmr::monotonic_buffer_resource arena;
+        const auto point = ArenaPoint{"a b,c=d", std::nullopt, &arena}
+                               .addTag("t k", "t,v")
+                               .addField("f=k", "\"q\"");
+
+        CHECK_THAT(lineOf(point), Equals(R"(a\ b\,c=d,t\ k=t\,v f\=k="\"q\"")"));
+    }
+
+    TEST_CASE("Arena point converts to point", "[ArenaPointTest]")
+    {
+        std::pmr::monotonic_buffer_resource arena;
+        const auto point = ArenaPoint{"cpu", ignoreTimestamp, &arena}
+                               .addTag("host", "host-1")
+                               .addField("procs", 12)
+                               .addField("state", "ok")
+                               .toPoint();
+
+        CHECK_THAT(point.getName(), Equals("cpu"));
+        CHECK_THAT(point.getTags(), Equals("host=host-1"));
+        CHECK_THAT(point.getFields(), Equals("procs=12i,state=\"ok\""));
+        CHECK(point.getTimestamp() == ignoreTimestamp);
+    }
+}
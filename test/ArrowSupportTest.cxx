@@ -0,0 +1,141 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InfluxDB/ColumnarResult.h"
+#include <arrow/api.h>
+#include <arrow/io/api.h>
+#include <arrow/ipc/api.h>
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+
+namespace influxdb::test
+{
+    namespace
+    {
+        template <class T>
+        T unwrap(::arrow::Result<T>&& result)
+        {
+            REQUIRE(result.ok());
+            return std::move(result).ValueUnsafe();
+        }
+
+        std::shared_ptr<::arrow::Array> finish(::arrow::ArrayBuilder& builder)
+        {
+            return unwrap(builder.Finish());
+        }
+
+        std::shared_ptr<::arrow::RecordBatch> createBatch(std::int64_t offset)
+        {
+            ::arrow::TimestampBuilder time{::arrow::timestamp(::arrow::TimeUnit::NANO), ::arrow::default_memory_pool()};
+            ::arrow::StringBuilder host;
+            ::arrow::DoubleBuilder usage;
+            ::arrow::Int32Builder count;
+
+            REQUIRE(time.AppendValues({offset, offset + 1}).ok());
+            REQUIRE(host.AppendValues({"host-a", "host-b"}).ok());
+            REQUIRE(usage.Append(0.5).ok());
+            REQUIRE(usage.AppendNull().ok());
+            REQUIRE(count.AppendValues({3, 4}).ok());
+
+            const auto schema = ::arrow::schema({::arrow::field("time", ::arrow::timestamp(::arrow::TimeUnit::NANO)),
+                                                 ::arrow::field("host", ::arrow::utf8()),
+                                                 ::arrow::field("usage", ::arrow::float64()),
+                                                 ::arrow::field("count", ::arrow::int32())});
+            return ::arrow::RecordBatch::Make(schema, 2, {finish(time), finish(host), finish(usage), finish(count)});
+        }
+
+        std::string writeStream(const std::vector<std::shared_ptr<::arrow::RecordBatch>>& batches)
+        {
+            auto sink = unwrap(::arrow::io::BufferOutputStream::Create());
+            auto writer = unwrap(::arrow::ipc::MakeStreamWriter(sink, batches.front()->schema()));
+
+            for (const auto& batch : batches)
+            {
+                REQUIRE(writer->WriteRecordBatch(*batch).ok());
+            }
+            REQUIRE(writer->Close().ok());
+            return unwrap(sink->Finish())->ToString();
+        }
+
+        void checkResult(const ColumnarResult& result)
+        {
+            REQUIRE(result.rows() == 4);
+            REQUIRE(result.columns().size() == 4);
+
+            CHECK(result.values<Column::TimeStamp>("time")[3].time_since_epoch() == std::chrono::nanoseconds{101});
+            CHECK(result.values<std::string>("host") == std::vector<std::string>{"host-a", "host-b", "host-a", "host-b"});
+            CHECK(result.values<double>("usage")[2] == 0.5);
+            CHECK(result.column("usage").isNull(1) == true);
+            CHECK(result.column("usage").isNull(2) == false);
+            CHECK(result.values<std::int64_t>("count") == std::vector<std::int64_t>{3, 4, 3, 4});
+            CHECK(result.column("count").validity.empty());
+        }
+    }
+
+
+    TEST_CASE("Read stream decodes all record batches", "[ArrowSupportTest]")
+    {
+        const auto data = writeStream({createBatch(0), createBatch(100)});
+        checkResult(readArrowStream(data));
+    }
+
+    TEST_CASE("Read file decodes all record batches", "[ArrowSupportTest]")
+    {
+        const auto path = std::filesystem::temp_directory_path() / "influxdb-cxx-arrow-support-test.arrow";
+        {
+            const auto batch = createBatch(0);
+            auto file = unwrap(::arrow::io::FileOutputStream::Open(path.string()));
+            auto writer = unwrap(::arrow::ipc::MakeFileWriter(file, batch->schema()));
+            REQUIRE(writer->WriteRecordBatch(*batch).ok());
+            REQUIRE(writer->WriteRecordBatch(*createBatch(100)).ok());
+            REQUIRE(writer->Close().ok());
+        }
+
+        checkResult(readArrowFile(path.string()));
+        std::filesystem::remove(path);
+    }
+
+    TEST_CASE("Read stream decodes dictionary encoded columns", "[ArrowSupportTest]")
+    {
+        ::arrow::StringBuilder dictionary;
+        ::arrow::Int8Builder indices;
+        REQUIRE(dictionary.AppendValues({"eu", "us"}).ok());
+        REQUIRE(indices.AppendValues({1, 0, 1}).ok());
+
+        const auto type = ::arrow::dictionary(::arrow::int8(), ::arrow::utf8());
+        const auto region = unwrap(::arrow::DictionaryArray::FromArrays(type, finish(indices), finish(dictionary)));
+        const auto batch = ::arrow::RecordBatch::Make(::arrow::schema({::arrow::field("region", type)}), 3, {region});
+
+        const auto result = readArrowStream(writeStream({batch}));
+        CHECK(result.values<std::string>("region") == std::vector<std::string>{"us", "eu", "us"});
+    }
+
+    TEST_CASE("Read stream throws on invalid data", "[ArrowSupportTest]")
+    {
+        CHECK_THROWS_AS(readArrowStream("not an arrow stream"), InfluxDBException);
+    }
+
+    TEST_CASE("Read file throws on missing file", "[ArrowSupportTest]")
+    {
+        CHECK_THROWS_AS(readArrowFile("/not/existing.arrow"), InfluxDBException);
+    }
+}
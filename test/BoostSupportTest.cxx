@@ -154,6 +154,179 @@ namespace influxdb::test
         CHECK(result[2].getFields() == "value=54.000000000000000000");
     }
 
+    TEST_CASE("Query decodes epoch timestamps", "[BoostSupportTest]")
+    {
+        using trompeloeil::_;
+
+        TransportMock transport;
+        ALLOW_CALL(transport, query(_))
+            .RETURN(R"({"results":[{"statement_id":0,)"
+                    R"("series":[{"name":"unittest","columns":["time","value"],)"
+                    R"("values":[[1609459882123,3],[1609459883000,4]]}]}]})");
+
+        const auto result = internal::queryImpl(&transport, "SELECT * from test", TimePrecision::MilliSeconds);
+        CHECK(result.size() == 2);
+        CHECK(result[0].getTimestamp() == std::chrono::system_clock::time_point{std::chrono::milliseconds{1609459882123}});
+        CHECK(result[1].getTimestamp() == std::chrono::system_clock::time_point{std::chrono::milliseconds{1609459883000}});
+        CHECK(result[1].getFields() == "value=4.000000000000000000");
+    }
+
+    TEST_CASE("Query throws on invalid epoch timestamp", "[BoostSupportTest]")
+    {
+        using trompeloeil::_;
+
+        TransportMock transport;
+        ALLOW_CALL(transport, query(_))
+            .RETURN(R"({"results":[{"statement_id":0,)"
+                    R"("series":[{"name":"unittest","columns":["time","value"],)"
+                    R"("values":[["2021-01-01T00:11:22.123456789Z",3]]}]}]})");
+
+        CHECK_THROWS_AS(internal::queryImpl(&transport, "SELECT * from test", TimePrecision::NanoSeconds), InfluxDBException);
+    }
+
+    TEST_CASE("Query keeps points of statements following an empty statement", "[BoostSupportTest]")
+    {
+        using trompeloeil::_;
+
+        TransportMock transport;
+        ALLOW_CALL(transport, query(_))
+            .RETURN(R"({"results":[{"statement_id":0,"series":[{"name":"a","columns":["time","value"],"values":[[1,1]]}]},)"
+                    R"({"statement_id":1},)"
+                    R"({"statement_id":2,"series":[{"name":"c","columns":["time","value"],"values":[[1,3]]}]}]})");
+
+        const auto result = internal::queryImpl(&transport, "SELECT * from a; SELECT * from b; SELECT * from c", TimePrecision::Seconds);
+        REQUIRE(result.size() == 2);
+        CHECK(result[0].getName() == "a");
+        CHECK(result[1].getName() == "c");
+    }
+
+    TEST_CASE("Query statements returns points per statement", "[BoostSupportTest]")
+    {
+        using trompeloeil::_;
+
+        TransportMock transport;
+        ALLOW_CALL(transport, query(_))
+            .RETURN(R"({"results":[{"statement_id":0,"series":[{"name":"a","columns":["time","value"],"values":[[1,1],[2,2]]}]},)"
+                    R"({"statement_id":1},)"
+                    R"({"statement_id":2,"series":[{"name":"c","columns":["time","value"],"values":[[1,3]]}]}]})");
+
+        const auto result = internal::queryStatementsImpl(&transport, "SELECT * from a; SELECT * from b; SELECT * from c", TimePrecision::Seconds);
+        REQUIRE(result.size() == 3);
+        CHECK(result[0].size() == 2);
+        CHECK(result[1].empty());
+        REQUIRE(result[2].size() == 1);
+        CHECK(result[2][0].getName() == "c");
+    }
+
+    TEST_CASE("Query decodes series in parallel preserving order", "[BoostSupportTest]")
+    {
+        using trompeloeil::_;
+
+        std::string response{R"({"results":[)"};
+        for (int statement = 0; statement < 4; ++statement)
+        {
+            response += (statement > 0 ? "," : "") + std::string{R"({"statement_id":)"} + std::to_string(statement) + R"(,"series":[)";
+            for (int series = 0; series < 5; ++series)
+            {
+                const auto name = std::to_string(statement * 5 + series);
+                response += (series > 0 ? "," : "") + std::string{R"({"name":")"} + name + R"(","columns":["time","value"],"values":[[1,)" + name + "],[2," + name + "]]}";
+            }
+            response += "]}";
+        }
+        response += "]}";
+
+        TransportMock transport;
+        ALLOW_CALL(transport, query(_)).RETURN(response);
+
+        internal::WorkerPool pool{3};
+
+        for (int query = 0; query < 2; ++query)
+        {
+            const auto result = internal::queryImpl(&transport, "SELECT * from test", TimePrecision::Seconds, &pool);
+            REQUIRE(result.size() == 40);
+            for (std::size_t i = 0; i < result.size(); ++i)
+            {
+                CHECK(result[i].getName() == std::to_string(i / 2));
+                CHECK(result[i].getTimestamp() == std::chrono::system_clock::time_point{std::chrono::seconds{1 + i % 2}});
+            }
+        }
+    }
+
+    TEST_CASE("Query stream passes points of all chunks", "[BoostSupportTest]")
+    {
+        using trompeloeil::_;
+
+        TransportMock transport;
+        REQUIRE_CALL(transport, queryChunked("SELECT * from test", 2, _))
+            .SIDE_EFFECT(_3(R"({"results":[{"statement_id":0,"series":[{"name":"x","columns":["time","value"],)"
+                            R"("values":[[1,10],[2,20]],"partial":true}],"partial":true}]})"))
+            .SIDE_EFFECT(_3(R"({"results":[{"statement_id":0,"series":[{"name":"x","columns":["time","value"],)"
+                            R"("values":[[3,30]]}]}]})"));
+
+        std::vector<Point> points{};
+        internal::queryStreamImpl(&transport, "SELECT * from test", 2, TimePrecision::Seconds, [&points](Point&& point)
+                                  { points.push_back(std::move(point)); });
+
+        CHECK(points.size() == 3);
+        CHECK(points[0].getFields() == "value=10.000000000000000000");
+        CHECK(points[1].getTimestamp() == std::chrono::system_clock::time_point{std::chrono::seconds{2}});
+        CHECK(points[2].getFields() == "value=30.000000000000000000");
+    }
+
+    TEST_CASE("Query stream skips chunks without series", "[BoostSupportTest]")
+    {
+        using trompeloeil::_;
+
+        TransportMock transport;
+        REQUIRE_CALL(transport, queryChunked(_, _, _)).SIDE_EFFECT(_3(R"({"results":[{"statement_id":0}]})"));
+
+        std::size_t count{0};
+        internal::queryStreamImpl(&transport, "SELECT * from test", 10, std::nullopt, [&count]([[maybe_unused]] Point&& point)
+                                  { ++count; });
+        CHECK(count == 0);
+    }
+
+    TEST_CASE("Query stream throws on error chunk", "[BoostSupportTest]")
+    {
+        using trompeloeil::_;
+
+        TransportMock transport;
+        REQUIRE_CALL(transport, queryChunked(_, _, _)).SIDE_EFFECT(_3(R"({"results":[{"statement_id":0,"error":"database not found: x"}]})"));
+
+        CHECK_THROWS_AS(internal::queryStreamImpl(&transport, "SELECT * from test", 10, std::nullopt, []([[maybe_unused]] Point&& point) {}), InfluxDBException);
+    }
+
+    TEST_CASE("Query statements throw on statement error", "[BoostSupportTest]")
+    {
+        using trompeloeil::_;
+
+        TransportMock transport;
+        ALLOW_CALL(transport, query(_)).RETURN(R"({"results":[{"statement_id":0,"series":[{"name":"x","columns":["time","value"],"values":[[1,10]]}]},)"
+                                               R"({"statement_id":1,"error":"measurement not found: y"}]})");
+
+        CHECK_THROWS_AS(internal::queryStatementsImpl(&transport, "SELECT * from x; SELECT * from y", std::nullopt), InfluxDBException);
+    }
+
+    TEST_CASE("Query stream throws on chunk which is not JSON", "[BoostSupportTest]")
+    {
+        using trompeloeil::_;
+
+        TransportMock transport;
+        REQUIRE_CALL(transport, queryChunked(_, _, _)).SIDE_EFFECT(_3("<html><body>502 Bad Gateway</body></html>"));
+
+        CHECK_THROWS_AS(internal::queryStreamImpl(&transport, "SELECT * from test", 10, std::nullopt, []([[maybe_unused]] Point&& point) {}), InfluxDBException);
+    }
+
+    TEST_CASE("Query throws on response which is not JSON", "[BoostSupportTest]")
+    {
+        using trompeloeil::_;
+
+        TransportMock transport;
+        ALLOW_CALL(transport, query(_)).RETURN("<html><body>502 Bad Gateway</body></html>");
+
+        CHECK_THROWS_AS(internal::queryImpl(&transport, "SELECT * from test"), InfluxDBException);
+    }
+
     TEST_CASE("Query throws on invalid result", "[BoostSupportTest]")
     {
         using trompeloeil::_;
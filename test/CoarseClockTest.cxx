@@ -0,0 +1,85 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InfluxDB/CoarseClock.h"
+#include "InfluxDB/Point.h"
+#include "InfluxDB/InfluxDBException.h"
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <thread>
+
+namespace influxdb::test
+{
+    using namespace std::chrono_literals;
+
+    TEST_CASE("Clock throws on invalid granularity", "[CoarseClockTest]")
+    {
+        CHECK_THROWS_AS(CoarseClock{0us}, InfluxDBException);
+    }
+
+    TEST_CASE("Clock is close to system clock", "[CoarseClockTest]")
+    {
+        const CoarseClock clock{1ms};
+        CHECK(clock.granularity() == 1ms);
+
+        const auto before = std::chrono::system_clock::now();
+        const auto now = clock.now();
+        CHECK(now <= std::chrono::system_clock::now());
+        CHECK(now > before - 1s);
+    }
+
+    TEST_CASE("Clock advances", "[CoarseClockTest]")
+    {
+        const CoarseClock clock{1ms};
+        const auto start = clock.now();
+
+        std::this_thread::sleep_for(20ms);
+        CHECK(clock.now() > start);
+    }
+
+    TEST_CASE("Point is timestamped by clock", "[CoarseClockTest]")
+    {
+        const auto clock = std::make_shared<const CoarseClock>(1h);
+        std::this_thread::sleep_for(2ms);
+
+        Point::setClock(clock);
+        const Point point{"test"};
+        Point::setClock(nullptr);
+
+        CHECK(point.getTimestamp() == clock->now());
+        CHECK(Point{"test"}.getTimestamp() > clock->now());
+    }
+
+    TEST_CASE("Clock is kept alive while set", "[CoarseClockTest]")
+    {
+        auto clock = std::make_shared<const CoarseClock>(1h);
+        const std::weak_ptr<const CoarseClock> observer{clock};
+        const auto timestamp = clock->now();
+
+        Point::setClock(std::move(clock));
+        CHECK_FALSE(observer.expired());
+        CHECK(Point{"test"}.getTimestamp() == timestamp);
+
+        Point::setClock(nullptr);
+        CHECK(observer.expired());
+    }
+}
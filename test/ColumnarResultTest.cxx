@@ -0,0 +1,79 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InfluxDB/ColumnarResult.h"
+#include <catch2/catch_test_macros.hpp>
+
+namespace influxdb::test
+{
+    namespace
+    {
+        ColumnarResult createResult()
+        {
+            return ColumnarResult{{Column{"host", std::vector<std::string>{"a", "b"}, {}},
+                                   Column{"value", std::vector<double>{1.5, 0.0}, {true, false}}}};
+        }
+    }
+
+
+    TEST_CASE("Default result is empty", "[ColumnarResultTest]")
+    {
+        const ColumnarResult result{};
+        CHECK(result.rows() == 0);
+        CHECK(result.columns().empty());
+    }
+
+    TEST_CASE("Result has rows of columns", "[ColumnarResultTest]")
+    {
+        const auto result = createResult();
+        CHECK(result.rows() == 2);
+        CHECK(result.columns().size() == 2);
+    }
+
+    TEST_CASE("Result returns values by column name", "[ColumnarResultTest]")
+    {
+        const auto result = createResult();
+        CHECK(result.values<std::string>("host") == std::vector<std::string>{"a", "b"});
+        CHECK(result.values<double>("value")[0] == 1.5);
+    }
+
+    TEST_CASE("Result throws on unknown column or type", "[ColumnarResultTest]")
+    {
+        const auto result = createResult();
+        CHECK_THROWS_AS(result.column("unknown"), InfluxDBException);
+        CHECK_THROWS_AS(result.values<std::int64_t>("value"), InfluxDBException);
+    }
+
+    TEST_CASE("Column reports null values", "[ColumnarResultTest]")
+    {
+        const auto result = createResult();
+        CHECK(result.column("host").isNull(1) == false);
+        CHECK(result.column("value").isNull(0) == false);
+        CHECK(result.column("value").isNull(1) == true);
+    }
+
+    TEST_CASE("Result throws on columns of different length", "[ColumnarResultTest]")
+    {
+        CHECK_THROWS_AS(ColumnarResult({Column{"a", std::vector<double>{1.0}, {}}, Column{"b", std::vector<double>{}, {}}}), InfluxDBException);
+        CHECK_THROWS_AS(ColumnarResult({Column{"a", std::vector<double>{1.0}, {true, true}}}), InfluxDBException);
+    }
+}
@@ -0,0 +1,204 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InfluxDB/Failover.h"
+#include "InfluxDB/InfluxDBException.h"
+#include "mock/RecordingTransport.h"
+#include <catch2/catch_test_macros.hpp>
+#include <thread>
+#include <vector>
+
+namespace influxdb::test
+{
+    using namespace std::chrono_literals;
+    using influxdb::transports::Failover;
+
+    namespace
+    {
+        template <class Predicate>
+        bool eventually(Predicate predicate)
+        {
+            const auto deadline = std::chrono::steady_clock::now() + 5s;
+            while (!predicate())
+            {
+                if (std::chrono::steady_clock::now() > deadline)
+                {
+                    return false;
+                }
+                std::this_thread::sleep_for(1ms);
+            }
+            return true;
+        }
+
+        std::vector<FailoverEndpoint> withHealthChecks(RecordingTransport& primary, RecordingTransport& primaryHealthCheck,
+                                                       RecordingTransport& secondary, RecordingTransport& secondaryHealthCheck)
+        {
+            std::vector<FailoverEndpoint> endpoints;
+            endpoints.push_back(FailoverEndpoint{std::make_unique<TransportRef>(primary), std::make_unique<TransportRef>(primaryHealthCheck)});
+            endpoints.push_back(FailoverEndpoint{std::make_unique<TransportRef>(secondary), std::make_unique<TransportRef>(secondaryHealthCheck)});
+            return endpoints;
+        }
+    }
+
+
+    TEST_CASE("Failover throws on missing endpoints", "[FailoverTest]")
+    {
+        CHECK_THROWS_AS(Failover{std::vector<std::unique_ptr<Transport>>{}}, InfluxDBException);
+
+        std::vector<std::unique_ptr<Transport>> endpoints;
+        endpoints.push_back(nullptr);
+        CHECK_THROWS_AS(Failover{std::move(endpoints)}, InfluxDBException);
+    }
+
+    TEST_CASE("Failover throws on invalid endpoint url", "[FailoverTest]")
+    {
+        CHECK_THROWS_AS(Failover{std::vector<std::string>{}}, InfluxDBException);
+        CHECK_THROWS_AS(Failover{std::vector<std::string>{"invalid"}}, InfluxDBException);
+    }
+
+    TEST_CASE("Failover routes to primary", "[FailoverTest]")
+    {
+        RecordingTransport primary;
+        RecordingTransport secondary;
+        Failover failover{transportsOf(primary, secondary)};
+
+        failover.send("p0 f=0i");
+        CHECK(primary.sent() == std::vector<std::string>{"p0 f=0i"});
+        CHECK(secondary.sent().empty());
+        CHECK(failover.activeEndpoint() == 0);
+    }
+
+    TEST_CASE("Failover repeats failed request on next endpoint", "[FailoverTest]")
+    {
+        RecordingTransport primary;
+        RecordingTransport secondary;
+        Failover failover{transportsOf(primary, secondary), {.healthCheckInterval = 1h}};
+
+        primary.reachable = false;
+        failover.send("p0 f=0i");
+        CHECK(secondary.sent() == std::vector<std::string>{"p0 f=0i"});
+        CHECK(failover.activeEndpoint() == 1);
+
+        CHECK(failover.query("SELECT") == "response of SELECT");
+        CHECK(secondary.queries == 1);
+    }
+
+    TEST_CASE("Failover doesn't ping healthy endpoints over request transport", "[FailoverTest]")
+    {
+        RecordingTransport primary;
+        RecordingTransport secondary;
+        Failover failover{transportsOf(primary, secondary), {.healthCheckInterval = 1ms}};
+
+        std::this_thread::sleep_for(20ms);
+        failover.send("p0 f=0i");
+        CHECK(primary.sent() == std::vector<std::string>{"p0 f=0i"});
+        CHECK(primary.pings == 0);
+        CHECK(secondary.pings == 0);
+    }
+
+    TEST_CASE("Failover passes errors of reachable endpoints", "[FailoverTest]")
+    {
+        RecordingTransport primary;
+        RecordingTransport secondary;
+        primary.rejected = "INVALID";
+        Failover failover{transportsOf(primary, secondary)};
+
+        CHECK_THROWS_AS(failover.query("INVALID"), InfluxDBException);
+        CHECK(secondary.queries == 0);
+        CHECK(failover.activeEndpoint() == 0);
+    }
+
+    TEST_CASE("Failover skips endpoints failing health check", "[FailoverTest]")
+    {
+        RecordingTransport primary;
+        RecordingTransport primaryHealthCheck;
+        RecordingTransport secondary;
+        RecordingTransport secondaryHealthCheck;
+        primaryHealthCheck.reachable = false;
+        Failover failover{withHealthChecks(primary, primaryHealthCheck, secondary, secondaryHealthCheck), {.healthCheckInterval = 1ms}};
+
+        REQUIRE(eventually([&failover]
+                           { return failover.activeEndpoint() == 1; }));
+        failover.send("p0 f=0i");
+        CHECK(secondary.sent() == std::vector<std::string>{"p0 f=0i"});
+        CHECK(primary.attempts == 0);
+    }
+
+    TEST_CASE("Failover restores recovered primary", "[FailoverTest]")
+    {
+        RecordingTransport primary;
+        RecordingTransport secondary;
+        primary.reachable = false;
+        Failover failover{transportsOf(primary, secondary), {.healthCheckInterval = 1ms}};
+        failover.send("p0 f=0i");
+        REQUIRE(failover.activeEndpoint() == 1);
+
+        primary.reachable = true;
+        REQUIRE(eventually([&failover]
+                           { return failover.activeEndpoint() == 0; }));
+        failover.send("p1 f=1i");
+        CHECK(primary.sent() == std::vector<std::string>{"p1 f=1i"});
+    }
+
+    TEST_CASE("Failover checks health by separate transports", "[FailoverTest]")
+    {
+        RecordingTransport primary;
+        RecordingTransport primaryHealthCheck;
+        RecordingTransport secondary;
+        RecordingTransport secondaryHealthCheck;
+        primaryHealthCheck.reachable = false;
+        Failover failover{withHealthChecks(primary, primaryHealthCheck, secondary, secondaryHealthCheck), {.healthCheckInterval = 1ms, .healthCheckTimeout = 100ms}};
+
+        CHECK(primaryHealthCheck.timeout == 100ms);
+        CHECK(secondaryHealthCheck.timeout == 100ms);
+        REQUIRE(eventually([&failover]
+                           { return failover.activeEndpoint() == 1; }));
+        failover.send("p0 f=0i");
+        CHECK(secondary.sent() == std::vector<std::string>{"p0 f=0i"});
+        CHECK(primary.pings == 0);
+        CHECK(secondary.pings == 0);
+    }
+
+    TEST_CASE("Failover throws if no endpoint is healthy", "[FailoverTest]")
+    {
+        RecordingTransport primary;
+        RecordingTransport secondary;
+        primary.reachable = false;
+        secondary.reachable = false;
+        Failover failover{transportsOf(primary, secondary), {.healthCheckInterval = 1ms}};
+
+        CHECK_THROWS_WITH(failover.send("p0 f=0i"), "No healthy endpoint (last error: endpoint 1: Unreachable)");
+        CHECK_FALSE(failover.ping());
+        CHECK(eventually([&failover]
+                         {
+                             try
+                             {
+                                 failover.send("p0 f=0i");
+                             }
+                             catch (const InfluxDBException& e)
+                             {
+                                 return std::string_view{e.what()}.ends_with(": Ping failed)");
+                             }
+                             return false;
+                         }));
+    }
+}
@@ -0,0 +1,193 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InfluxDB/FanOut.h"
+#include "InfluxDB/InfluxDBException.h"
+#include "mock/RecordingTransport.h"
+#include <catch2/catch_test_macros.hpp>
+#include <thread>
+#include <vector>
+
+namespace influxdb::test
+{
+    using namespace std::chrono_literals;
+    using influxdb::transports::FanOut;
+
+    namespace
+    {
+        constexpr FanOutOptions noBackoff{.maxQueuedMessages = 10000, .retryPolicy = {.maxAttempts = 3, .initialBackoff = 0ms}};
+    }
+
+
+    TEST_CASE("Fan-out throws on missing replicas", "[FanOutTest]")
+    {
+        CHECK_THROWS_AS(FanOut{{}}, InfluxDBException);
+
+        std::vector<std::unique_ptr<Transport>> replicas;
+        replicas.push_back(nullptr);
+        CHECK_THROWS_AS(FanOut{std::move(replicas)}, InfluxDBException);
+    }
+
+    TEST_CASE("Fan-out sends messages to all replicas", "[FanOutTest]")
+    {
+        RecordingTransport first;
+        RecordingTransport second;
+        FanOut fanOut{transportsOf(first, second)};
+
+        fanOut.send("p0 f=0i");
+        fanOut.send("p1 f=1i");
+        REQUIRE(fanOut.drain(5s));
+
+        CHECK(first.sent() == std::vector<std::string>{"p0 f=0i", "p1 f=1i"});
+        CHECK(second.sent() == std::vector<std::string>{"p0 f=0i", "p1 f=1i"});
+        CHECK(fanOut.stats(0).sent == 2);
+        CHECK(fanOut.stats(1).sent == 2);
+    }
+
+    TEST_CASE("Fan-out is not stalled by a slow replica", "[FanOutTest]")
+    {
+        RecordingTransport first;
+        RecordingTransport second;
+        second.blocking = true;
+        FanOut fanOut{transportsOf(first, second)};
+
+        fanOut.send("p0 f=0i");
+        fanOut.send("p1 f=1i");
+
+        while (first.sent().size() < 2)
+        {
+            std::this_thread::yield();
+        }
+        CHECK(second.sent().empty());
+        CHECK(fanOut.stats(1).pending == 2);
+
+        second.unblock();
+        REQUIRE(fanOut.drain(5s));
+        CHECK(second.sent() == std::vector<std::string>{"p0 f=0i", "p1 f=1i"});
+    }
+
+    TEST_CASE("Fan-out retries failed sends per replica", "[FanOutTest]")
+    {
+        RecordingTransport first;
+        RecordingTransport second;
+        second.failures = 2;
+        FanOut fanOut{transportsOf(first, second), noBackoff};
+
+        fanOut.send("p0 f=0i");
+        REQUIRE(fanOut.drain(5s));
+
+        CHECK(first.attempts == 1);
+        CHECK(second.attempts == 3);
+        CHECK(second.sent() == std::vector<std::string>{"p0 f=0i"});
+    }
+
+    TEST_CASE("Fan-out drops message after last attempt", "[FanOutTest]")
+    {
+        RecordingTransport first;
+        RecordingTransport second;
+        second.failures = 3;
+        FanOut fanOut{transportsOf(first, second), noBackoff};
+
+        fanOut.send("p0 f=0i");
+        fanOut.send("p1 f=1i");
+        REQUIRE(fanOut.drain(5s));
+
+        CHECK(second.sent() == std::vector<std::string>{"p1 f=1i"});
+        CHECK(fanOut.stats(1).dropped == 1);
+        CHECK(fanOut.stats(1).sent == 1);
+    }
+
+    TEST_CASE("Fan-out retries unreachable replica", "[FanOutTest]")
+    {
+        RecordingTransport first;
+        first.reachable = false;
+        FanOut fanOut{transportsOf(first), noBackoff};
+
+        fanOut.send("p0 f=0i");
+        REQUIRE(fanOut.drain(5s));
+
+        CHECK(first.attempts == 3);
+        CHECK(fanOut.stats(0).dropped == 1);
+    }
+
+    TEST_CASE("Fan-out doesn't retry rejected messages", "[FanOutTest]")
+    {
+        RecordingTransport first;
+        first.rejected = "p0 f=bad";
+        FanOut fanOut{transportsOf(first), noBackoff};
+
+        fanOut.send("p0 f=bad");
+        fanOut.send("p1 f=1i");
+        REQUIRE(fanOut.drain(5s));
+
+        CHECK(first.attempts == 2);
+        CHECK(first.sent() == std::vector<std::string>{"p1 f=1i"});
+        CHECK(fanOut.stats(0).dropped == 1);
+    }
+
+    TEST_CASE("Fan-out drops oldest messages if queue is full", "[FanOutTest]")
+    {
+        RecordingTransport first;
+        RecordingTransport second;
+        second.blocking = true;
+        FanOut fanOut{transportsOf(first, second), {.maxQueuedMessages = 1}};
+
+        fanOut.send("p0 f=0i");
+        while (fanOut.stats(1).pending != 1 || second.attempts == 0)
+        {
+            std::this_thread::yield();
+        }
+        fanOut.send("p1 f=1i");
+        fanOut.send("p2 f=2i");
+
+        CHECK(fanOut.stats(1).dropped == 1);
+        second.unblock();
+        REQUIRE(fanOut.drain(5s));
+        CHECK(second.sent() == std::vector<std::string>{"p0 f=0i", "p2 f=2i"});
+    }
+
+    TEST_CASE("Fan-out queries the first replica", "[FanOutTest]")
+    {
+        RecordingTransport first;
+        RecordingTransport second;
+        FanOut fanOut{transportsOf(first, second)};
+
+        CHECK(fanOut.query("SELECT") == "response of SELECT");
+        CHECK(first.queries == 1);
+        CHECK(second.queries == 0);
+    }
+
+    TEST_CASE("Fan-out applies settings to all replicas", "[FanOutTest]")
+    {
+        RecordingTransport first;
+        RecordingTransport second;
+        FanOut fanOut{transportsOf(first, second)};
+
+        fanOut.setTimePrecision(TimePrecision::Seconds);
+        CHECK(first.timePrecision == TimePrecision::Seconds);
+        CHECK(second.timePrecision == TimePrecision::Seconds);
+
+        fanOut.setTimeout(250ms);
+        CHECK(first.timeout == 250ms);
+        CHECK(second.timeout == 250ms);
+    }
+}
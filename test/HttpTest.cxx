@@ -23,8 +23,10 @@
 #include "HTTP.h"
 #include "InfluxDB/InfluxDBException.h"
 #include "InfluxDB/TimePrecision.h"
+#include "InfluxDB/RetryPolicy.h"
 #include "mock/CprMock.h"
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
 #include <catch2/trompeloeil.hpp>
 
 namespace influxdb::test
@@ -34,6 +36,7 @@ namespace influxdb::test
     using influxdb::transports::HTTP;
     using trompeloeil::_;
     using trompeloeil::eq;
+    using Catch::Matchers::ContainsSubstring;
 
     using ParamMap = std::map<std::string, std::string>;
 
@@ -66,6 +69,8 @@ namespace influxdb::test
         REQUIRE_THROWS_AS(HTTP{"http://localhost:8086?dc=test"}, InfluxDBException);
         REQUIRE_THROWS_AS(HTTP{"http://localhost:8086?dbtest"}, InfluxDBException);
         REQUIRE_THROWS_AS(HTTP{"http://localhost:8086?db-test"}, InfluxDBException);
+        REQUIRE_THROWS_AS(HTTP{"http://localhost:8086?org=the-org"}, InfluxDBException);
+        REQUIRE_THROWS_AS(HTTP{"http://localhost:8086?bucket=the-bucket"}, InfluxDBException);
     }
 
     TEST_CASE("Construction sets session settings", "[HttpTest]")
@@ -83,13 +88,76 @@ namespace influxdb::test
 
         REQUIRE_CALL(sessionMock, Post()).RETURN(createResponse(cpr::ErrorCode::OK, cpr::status::HTTP_OK));
         REQUIRE_CALL(sessionMock, SetUrl(eq("http://localhost:8086/write")));
-        REQUIRE_CALL(sessionMock, UpdateHeader(_)).WITH(_1.at("Content-Type") == "application/json");
+        REQUIRE_CALL(sessionMock, UpdateHeader(_)).WITH(_1.at("Content-Type") == "text/plain; charset=utf-8");
         REQUIRE_CALL(sessionMock, SetBody(_)).WITH(_1.str() == data);
         REQUIRE_CALL(sessionMock, SetParameters(ParamMap{{"db", "test"}}));
 
         http.send(std::string{data});
     }
 
+    TEST_CASE("Send to v2 API sets parameters", "[HttpTest]")
+    {
+        ALLOW_CALL(sessionMock, SetTimeout(_));
+        ALLOW_CALL(sessionMock, SetConnectTimeout(_));
+        HTTP http{"http://localhost:8086?org=the-org&bucket=the-bucket"};
+        http.setTimePrecision(TimePrecision::MicroSeconds);
+        const std::string data{"content-to-send"};
+
+        REQUIRE_CALL(sessionMock, Post()).RETURN(createResponse(cpr::ErrorCode::OK, cpr::status::HTTP_NO_CONTENT));
+        REQUIRE_CALL(sessionMock, SetUrl(eq("http://localhost:8086/api/v2/write")));
+        REQUIRE_CALL(sessionMock, UpdateHeader(_)).WITH(_1.at("Content-Type") == "text/plain; charset=utf-8");
+        REQUIRE_CALL(sessionMock, SetBody(_)).WITH(_1.str() == data);
+        REQUIRE_CALL(sessionMock, SetParameters(ParamMap{{"org", "the-org"}, {"bucket", "the-bucket"}, {"precision", "us"}}));
+
+        http.send(std::string{data});
+    }
+
+    TEST_CASE("Send to v2 API set by bucket", "[HttpTest]")
+    {
+        auto http = createHttp();
+        http.setBucket("the-org", "the-bucket");
+
+        REQUIRE_CALL(sessionMock, Post()).RETURN(createResponse(cpr::ErrorCode::OK, cpr::status::HTTP_NO_CONTENT));
+        REQUIRE_CALL(sessionMock, SetUrl(eq("http://localhost:8086/api/v2/write")));
+        REQUIRE_CALL(sessionMock, SetParameters(ParamMap{{"org", "the-org"}, {"bucket", "the-bucket"}}));
+        ALLOW_CALL(sessionMock, UpdateHeader(_));
+        ALLOW_CALL(sessionMock, SetBody(_));
+
+        http.send("content");
+    }
+
+    TEST_CASE("Send to v2 API throws on unsupported precision", "[HttpTest]")
+    {
+        auto http = createHttp();
+        http.setBucket("the-org", "the-bucket");
+        http.setTimePrecision(TimePrecision::Hours);
+
+        ALLOW_CALL(sessionMock, SetUrl(_));
+        ALLOW_CALL(sessionMock, UpdateHeader(_));
+
+        REQUIRE_THROWS_AS(http.send("content"), InfluxDBException);
+    }
+
+    TEST_CASE("Set bucket throws on empty values", "[HttpTest]")
+    {
+        auto http = createHttp();
+        REQUIRE_THROWS_AS(http.setBucket("", "the-bucket"), InfluxDBException);
+        REQUIRE_THROWS_AS(http.setBucket("the-org", ""), InfluxDBException);
+    }
+
+    TEST_CASE("Query of v2 url uses bucket as database", "[HttpTest]")
+    {
+        ALLOW_CALL(sessionMock, SetTimeout(_));
+        ALLOW_CALL(sessionMock, SetConnectTimeout(_));
+        HTTP http{"http://localhost:8086?org=the-org&bucket=the-bucket"};
+
+        REQUIRE_CALL(sessionMock, Get()).RETURN(createResponse(cpr::ErrorCode::OK, cpr::status::HTTP_OK, "query-result"));
+        REQUIRE_CALL(sessionMock, SetUrl(eq("http://localhost:8086/query")));
+        REQUIRE_CALL(sessionMock, SetParameters(ParamMap{{"db", "the-bucket"}, {"q", "SELECT * FROM test"}}));
+
+        CHECK(http.query("SELECT * FROM test") == "query-result");
+    }
+
     TEST_CASE("Send fails on unsuccessful execution", "[HttpTest]")
     {
         auto http = createHttp();
@@ -129,6 +197,201 @@ namespace influxdb::test
         REQUIRE_THROWS_AS(http.send("content"), InfluxDBException);
     }
 
+    TEST_CASE("Send throws with message of error response", "[HttpTest]")
+    {
+        auto http = createHttp();
+
+        REQUIRE_CALL(sessionMock, Post()).RETURN(createResponse(cpr::ErrorCode::OK, cpr::status::HTTP_BAD_REQUEST, R"({"error":"partial write: field type conflict"})"));
+        ALLOW_CALL(sessionMock, SetUrl(_));
+        ALLOW_CALL(sessionMock, UpdateHeader(_));
+        ALLOW_CALL(sessionMock, SetBody(_));
+        ALLOW_CALL(sessionMock, SetParameters(_));
+
+        REQUIRE_THROWS_WITH(http.send("content"), ContainsSubstring("message: 'partial write: field type conflict'"));
+    }
+
+    TEST_CASE("Send isolates lines rejected by parse error", "[HttpTest]")
+    {
+        auto http = createHttp();
+        std::vector<std::string> rejected{};
+        http.setPartialWriteHandler([&rejected](std::string_view line, const std::string& error)
+                                    {
+                                        CHECK(error == "unable to parse 'bad': invalid field format");
+                                        rejected.emplace_back(line);
+                                    });
+
+        std::string body{};
+        ALLOW_CALL(sessionMock, SetBody(_)).SIDE_EFFECT(body = _1.str());
+        ALLOW_CALL(sessionMock, Post())
+            .RETURN(body.find("bad") == std::string::npos
+                        ? createResponse(cpr::ErrorCode::OK, cpr::status::HTTP_NO_CONTENT, "")
+                        : createResponse(cpr::ErrorCode::OK, cpr::status::HTTP_BAD_REQUEST, R"({"error":"unable to parse 'bad': invalid field format"})"));
+        ALLOW_CALL(sessionMock, SetUrl(_));
+        ALLOW_CALL(sessionMock, UpdateHeader(_));
+        ALLOW_CALL(sessionMock, SetParameters(_));
+
+        http.send("m0 v=1\nbad1 v=1\nm2 v=1\nm3 v=1\nbad4 v=1");
+        CHECK(rejected == std::vector<std::string>{"bad1 v=1", "bad4 v=1"});
+    }
+
+    TEST_CASE("Send reports lines named by partial write without resending", "[HttpTest]")
+    {
+        auto http = createHttp();
+        std::vector<std::string> rejected{};
+        http.setPartialWriteHandler([&rejected](std::string_view line, const std::string&)
+                                    { rejected.emplace_back(line); });
+
+        REQUIRE_CALL(sessionMock, Post())
+            .RETURN(createResponse(cpr::ErrorCode::OK, cpr::status::HTTP_BAD_REQUEST,
+                                   R"({"error":"partial write: unable to parse 'bad1 v=x': invalid boolean\nunable to parse 'bad4 v=x': invalid boolean dropped=2"})"));
+        REQUIRE_CALL(sessionMock, SetBody(_)).WITH(_1.str() == "m0 v=1\nbad1 v=x\nm2 v=1\nbad4 v=x");
+        ALLOW_CALL(sessionMock, SetUrl(_));
+        ALLOW_CALL(sessionMock, UpdateHeader(_));
+        ALLOW_CALL(sessionMock, SetParameters(_));
+
+        http.send("m0 v=1\nbad1 v=x\nm2 v=1\nbad4 v=x");
+        CHECK(rejected == std::vector<std::string>{"bad1 v=x", "bad4 v=x"});
+    }
+
+    TEST_CASE("Send reports lines numbered by partial write without resending", "[HttpTest]")
+    {
+        auto http = createHttp();
+        std::vector<std::string> rejected{};
+        http.setPartialWriteHandler([&rejected](std::string_view line, const std::string&)
+                                    { rejected.emplace_back(line); });
+
+        REQUIRE_CALL(sessionMock, Post())
+            .RETURN(createResponse(cpr::ErrorCode::OK, cpr::status::HTTP_BAD_REQUEST,
+                                   R"({"code":"invalid","message":"partial write has occurred, errors encountered on line(s): line 2: invalid field format"})"));
+        REQUIRE_CALL(sessionMock, SetBody(_));
+        ALLOW_CALL(sessionMock, SetUrl(_));
+        ALLOW_CALL(sessionMock, UpdateHeader(_));
+        ALLOW_CALL(sessionMock, SetParameters(_));
+
+        http.send("m0 v=1\nbad1 v=x\nm2 v=1");
+        CHECK(rejected == std::vector<std::string>{"bad1 v=x"});
+    }
+
+    TEST_CASE("Send reports partial write naming no line without resending", "[HttpTest]")
+    {
+        auto http = createHttp();
+        std::vector<std::string> rejected{};
+        http.setPartialWriteHandler([&rejected](std::string_view line, const std::string& error)
+                                    {
+                                        CHECK(error == "partial write: field type conflict");
+                                        rejected.emplace_back(line);
+                                    });
+
+        REQUIRE_CALL(sessionMock, Post()).RETURN(createResponse(cpr::ErrorCode::OK, cpr::status::HTTP_BAD_REQUEST, R"({"error":"partial write: field type conflict"})"));
+        REQUIRE_CALL(sessionMock, SetBody(_));
+        ALLOW_CALL(sessionMock, SetUrl(_));
+        ALLOW_CALL(sessionMock, UpdateHeader(_));
+        ALLOW_CALL(sessionMock, SetParameters(_));
+
+        http.send("m0 v=1\nbad1 v=1\nm2 v=1");
+        CHECK(rejected == std::vector<std::string>{""});
+    }
+
+    TEST_CASE("Send with partial write handler throws on other failures", "[HttpTest]")
+    {
+        auto http = createHttp();
+        http.setPartialWriteHandler([](std::string_view, const std::string&)
+                                    { FAIL("Unexpected call"); });
+
+        REQUIRE_CALL(sessionMock, Post()).RETURN(createResponse(cpr::ErrorCode::OK, cpr::status::HTTP_NOT_FOUND, R"({"error":"database not found"})"));
+        ALLOW_CALL(sessionMock, SetUrl(_));
+        ALLOW_CALL(sessionMock, UpdateHeader(_));
+        ALLOW_CALL(sessionMock, SetBody(_));
+        ALLOW_CALL(sessionMock, SetParameters(_));
+
+        REQUIRE_THROWS_AS(http.send("m0 v=1\nm1 v=1"), InfluxDBException);
+    }
+
+    TEST_CASE("Send retries transient failure", "[HttpTest]")
+    {
+        auto http = createHttp();
+        http.setRetryPolicy(RetryPolicy{3, std::chrono::milliseconds{0}, std::chrono::milliseconds{0}, 2.0, false});
+
+        trompeloeil::sequence seq;
+        REQUIRE_CALL(sessionMock, Post()).RETURN(createResponse(cpr::ErrorCode::OPERATION_TIMEDOUT, cpr::status::HTTP_OK)).IN_SEQUENCE(seq);
+        REQUIRE_CALL(sessionMock, Post()).RETURN(createResponse(cpr::ErrorCode::OK, cpr::status::HTTP_SERVICE_UNAVAILABLE)).IN_SEQUENCE(seq);
+        REQUIRE_CALL(sessionMock, Post()).RETURN(createResponse(cpr::ErrorCode::OK, cpr::status::HTTP_NO_CONTENT)).IN_SEQUENCE(seq);
+        ALLOW_CALL(sessionMock, SetUrl(_));
+        ALLOW_CALL(sessionMock, UpdateHeader(_));
+        ALLOW_CALL(sessionMock, SetBody(_));
+        ALLOW_CALL(sessionMock, SetParameters(_));
+
+        http.send("content");
+    }
+
+    TEST_CASE("Send throws if retries are exhausted", "[HttpTest]")
+    {
+        auto http = createHttp();
+        http.setRetryPolicy(RetryPolicy{2, std::chrono::milliseconds{0}, std::chrono::milliseconds{0}, 2.0, false});
+
+        REQUIRE_CALL(sessionMock, Post()).TIMES(2).RETURN(createResponse(cpr::ErrorCode::OK, cpr::status::HTTP_TOO_MANY_REQUESTS));
+        ALLOW_CALL(sessionMock, SetUrl(_));
+        ALLOW_CALL(sessionMock, UpdateHeader(_));
+        ALLOW_CALL(sessionMock, SetBody(_));
+        ALLOW_CALL(sessionMock, SetParameters(_));
+
+        REQUIRE_THROWS_AS(http.send("content"), InfluxDBException);
+    }
+
+    TEST_CASE("Send does not retry permanent failure", "[HttpTest]")
+    {
+        auto http = createHttp();
+        http.setRetryPolicy(RetryPolicy{3, std::chrono::milliseconds{0}, std::chrono::milliseconds{0}, 2.0, false});
+
+        REQUIRE_CALL(sessionMock, Post()).TIMES(1).RETURN(createResponse(cpr::ErrorCode::OK, cpr::status::HTTP_BAD_REQUEST));
+        ALLOW_CALL(sessionMock, SetUrl(_));
+        ALLOW_CALL(sessionMock, UpdateHeader(_));
+        ALLOW_CALL(sessionMock, SetBody(_));
+        ALLOW_CALL(sessionMock, SetParameters(_));
+
+        REQUIRE_THROWS_AS(http.send("content"), InfluxDBException);
+    }
+
+    TEST_CASE("Send honours Retry-After header", "[HttpTest]")
+    {
+        auto http = createHttp();
+        http.setRetryPolicy(RetryPolicy{2, std::chrono::milliseconds{0}, std::chrono::seconds{10}, 2.0, false});
+        auto throttled = createResponse(cpr::ErrorCode::OK, cpr::status::HTTP_TOO_MANY_REQUESTS);
+        throttled.header["Retry-After"] = "1";
+
+        trompeloeil::sequence seq;
+        REQUIRE_CALL(sessionMock, Post()).RETURN(throttled).IN_SEQUENCE(seq);
+        REQUIRE_CALL(sessionMock, Post()).RETURN(createResponse(cpr::ErrorCode::OK, cpr::status::HTTP_NO_CONTENT)).IN_SEQUENCE(seq);
+        ALLOW_CALL(sessionMock, SetUrl(_));
+        ALLOW_CALL(sessionMock, UpdateHeader(_));
+        ALLOW_CALL(sessionMock, SetBody(_));
+        ALLOW_CALL(sessionMock, SetParameters(_));
+
+        const auto start = std::chrono::steady_clock::now();
+        http.send("content");
+        CHECK(std::chrono::steady_clock::now() - start >= std::chrono::seconds{1});
+    }
+
+    TEST_CASE("Send bounds Retry-After header by max backoff", "[HttpTest]")
+    {
+        auto http = createHttp();
+        http.setRetryPolicy(RetryPolicy{2, std::chrono::milliseconds{0}, std::chrono::milliseconds{10}, 2.0, false});
+        auto throttled = createResponse(cpr::ErrorCode::OK, cpr::status::HTTP_TOO_MANY_REQUESTS);
+        throttled.header["Retry-After"] = "3600";
+
+        trompeloeil::sequence seq;
+        REQUIRE_CALL(sessionMock, Post()).RETURN(throttled).IN_SEQUENCE(seq);
+        REQUIRE_CALL(sessionMock, Post()).RETURN(createResponse(cpr::ErrorCode::OK, cpr::status::HTTP_NO_CONTENT)).IN_SEQUENCE(seq);
+        ALLOW_CALL(sessionMock, SetUrl(_));
+        ALLOW_CALL(sessionMock, UpdateHeader(_));
+        ALLOW_CALL(sessionMock, SetBody(_));
+        ALLOW_CALL(sessionMock, SetParameters(_));
+
+        const auto start = std::chrono::steady_clock::now();
+        http.send("content");
+        CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds{1});
+    }
+
     TEST_CASE("Query sets parameters", "[HttpTest]")
     {
         auto http = createHttp();
@@ -174,6 +437,117 @@ namespace influxdb::test
         REQUIRE_THROWS_AS(http.query("/12?ab=cd"), InfluxDBException);
     }
 
+    TEST_CASE("Query retries transient failure", "[HttpTest]")
+    {
+        auto http = createHttp();
+        http.setRetryPolicy(RetryPolicy{2, std::chrono::milliseconds{0}, std::chrono::milliseconds{0}, 2.0, false});
+
+        trompeloeil::sequence seq;
+        REQUIRE_CALL(sessionMock, Get()).RETURN(createResponse(cpr::ErrorCode::COULDNT_CONNECT, cpr::status::HTTP_OK)).IN_SEQUENCE(seq);
+        REQUIRE_CALL(sessionMock, Get()).RETURN(createResponse(cpr::ErrorCode::OK, cpr::status::HTTP_OK, "query-result")).IN_SEQUENCE(seq);
+        ALLOW_CALL(sessionMock, SetUrl(_));
+        ALLOW_CALL(sessionMock, SetParameters(_));
+
+        CHECK(http.query("SELECT * FROM test") == "query-result");
+    }
+
+    TEST_CASE("Query chunked sets parameters", "[HttpTest]")
+    {
+        auto http = createHttp();
+        const std::string query{"/12?ab=cd"};
+
+        REQUIRE_CALL(sessionMock, Get()).RETURN(createResponse(cpr::ErrorCode::OK, cpr::status::HTTP_OK, ""));
+        REQUIRE_CALL(sessionMock, SetUrl(eq("http://localhost:8086/query")));
+        REQUIRE_CALL(sessionMock, SetParameters(ParamMap{{"db", "test"}, {"q", query}, {"chunked", "true"}, {"chunk_size", "500"}}));
+        ALLOW_CALL(sessionMock, SetWriteCallback(_));
+        ALLOW_CALL(sessionMock, SetHeaderCallback(_));
+
+        http.queryChunked(query, 500, []([[maybe_unused]] std::string_view chunk) {});
+    }
+
+    TEST_CASE("Query chunked passes complete chunks", "[HttpTest]")
+    {
+        auto http = createHttp();
+        cpr::WriteCallback writeCallback{};
+        cpr::HeaderCallback headerCallback{};
+        std::vector<std::string> chunks{};
+
+        ALLOW_CALL(sessionMock, SetUrl(_));
+        ALLOW_CALL(sessionMock, SetParameters(_));
+        REQUIRE_CALL(sessionMock, SetWriteCallback(_)).LR_SIDE_EFFECT(writeCallback = _1);
+        REQUIRE_CALL(sessionMock, SetWriteCallback(_)).WITH(!_1.callback);
+        REQUIRE_CALL(sessionMock, SetHeaderCallback(_)).LR_SIDE_EFFECT(headerCallback = _1);
+        REQUIRE_CALL(sessionMock, SetHeaderCallback(_)).WITH(!_1.callback);
+        REQUIRE_CALL(sessionMock, Get())
+            .LR_SIDE_EFFECT(headerCallback.callback("HTTP/1.1 200 OK\r\n", 0))
+            .LR_SIDE_EFFECT(writeCallback.callback(R"({"a":1})"
+                                                   "\n"
+                                                   R"({"b")",
+                                                   0))
+            .LR_SIDE_EFFECT(writeCallback.callback(":2}\n{\"c\":3}", 0))
+            .RETURN(createResponse(cpr::ErrorCode::OK, cpr::status::HTTP_OK, ""));
+
+        http.queryChunked("select", 10, [&chunks](std::string_view chunk)
+                          { chunks.emplace_back(chunk); });
+        CHECK(chunks == std::vector<std::string>{R"({"a":1})", R"({"b":2})", R"({"c":3})"});
+    }
+
+    TEST_CASE("Query chunked throws on unsuccessful response", "[HttpTest]")
+    {
+        auto http = createHttp();
+
+        REQUIRE_CALL(sessionMock, Get()).RETURN(createResponse(cpr::ErrorCode::OK, cpr::status::HTTP_BAD_GATEWAY, ""));
+        ALLOW_CALL(sessionMock, SetUrl(_));
+        ALLOW_CALL(sessionMock, SetParameters(_));
+        ALLOW_CALL(sessionMock, SetWriteCallback(_));
+        ALLOW_CALL(sessionMock, SetHeaderCallback(_));
+
+        REQUIRE_THROWS_AS(http.queryChunked("select", 10, []([[maybe_unused]] std::string_view chunk) {}), InfluxDBException);
+    }
+
+    TEST_CASE("Query chunked passes no chunks of unsuccessful response", "[HttpTest]")
+    {
+        auto http = createHttp();
+        cpr::WriteCallback writeCallback{};
+        cpr::HeaderCallback headerCallback{};
+
+        ALLOW_CALL(sessionMock, SetUrl(_));
+        ALLOW_CALL(sessionMock, SetParameters(_));
+        ALLOW_CALL(sessionMock, SetWriteCallback(_)).LR_SIDE_EFFECT(writeCallback = _1);
+        ALLOW_CALL(sessionMock, SetHeaderCallback(_)).LR_SIDE_EFFECT(headerCallback = _1);
+        REQUIRE_CALL(sessionMock, Get())
+            .LR_SIDE_EFFECT(headerCallback.callback("HTTP/1.1 401 Unauthorized\r\n", 0))
+            .LR_SIDE_EFFECT(headerCallback.callback("Content-Type: application/json\r\n", 0))
+            .LR_SIDE_EFFECT(CHECK(writeCallback.callback("{\"error\":\"authorization failed\"}\n", 0)))
+            .RETURN(createResponse(cpr::ErrorCode::OK, cpr::status::HTTP_UNAUTHORIZED, ""));
+
+        REQUIRE_THROWS_WITH(http.queryChunked("select", 10, []([[maybe_unused]] std::string_view chunk)
+                                              { FAIL("Unexpected call"); }),
+                            ContainsSubstring("(401)") && ContainsSubstring("message: 'authorization failed'"));
+    }
+
+    TEST_CASE("Query chunked rethrows exception of chunk handler", "[HttpTest]")
+    {
+        auto http = createHttp();
+        cpr::WriteCallback writeCallback{};
+        cpr::HeaderCallback headerCallback{};
+
+        ALLOW_CALL(sessionMock, SetUrl(_));
+        ALLOW_CALL(sessionMock, SetParameters(_));
+        REQUIRE_CALL(sessionMock, SetWriteCallback(_)).LR_SIDE_EFFECT(writeCallback = _1);
+        REQUIRE_CALL(sessionMock, SetWriteCallback(_)).WITH(!_1.callback);
+        REQUIRE_CALL(sessionMock, SetHeaderCallback(_)).LR_SIDE_EFFECT(headerCallback = _1);
+        REQUIRE_CALL(sessionMock, SetHeaderCallback(_)).WITH(!_1.callback);
+        REQUIRE_CALL(sessionMock, Get())
+            .LR_SIDE_EFFECT(headerCallback.callback("HTTP/1.1 200 OK\r\n", 0))
+            .LR_SIDE_EFFECT(CHECK_FALSE(writeCallback.callback("{}\n", 0)))
+            .RETURN(createResponse(cpr::ErrorCode::UNKNOWN_ERROR, cpr::status::HTTP_OK, ""));
+
+        REQUIRE_THROWS_AS(http.queryChunked("select", 10, []([[maybe_unused]] std::string_view chunk)
+                                            { throw std::runtime_error{"Intentional"}; }),
+                          std::runtime_error);
+    }
+
     TEST_CASE("Create database sets parameters", "[HttpTest]")
     {
         auto http = createHttp();
@@ -264,6 +638,17 @@ namespace influxdb::test
         http.setVerifyCertificate(true);
     }
 
+    TEST_CASE("Set HTTP/2 sets http version", "[HttpTest]")
+    {
+        auto http = createHttp();
+
+        REQUIRE_CALL(sessionMock, SetHttpVersion(_)).WITH(_1.code == cpr::HttpVersionCode::VERSION_2_0);
+        http.setHttp2(true);
+
+        REQUIRE_CALL(sessionMock, SetHttpVersion(_)).WITH(_1.code == cpr::HttpVersionCode::VERSION_NONE);
+        http.setHttp2(false);
+    }
+
     TEST_CASE("Set timeout sets timeouts", "[HttpTest]")
     {
         constexpr std::chrono::seconds timeout{3};
@@ -354,6 +739,19 @@ namespace influxdb::test
         http.query(query);
     }
 
+    TEST_CASE("Set query epoch sets epoch on query", "[HttpTest]")
+    {
+        auto http = createHttp();
+        const std::string query = "/12?ab=cd";
+
+        ALLOW_CALL(sessionMock, Get()).RETURN(createResponse(cpr::ErrorCode::OK, cpr::status::HTTP_OK, "query-result"));
+        ALLOW_CALL(sessionMock, SetUrl(_));
+        REQUIRE_CALL(sessionMock, SetParameters(ParamMap{{"db", "test"}, {"q", query}, {"epoch", "ms"}}));
+
+        http.setQueryEpoch(TimePrecision::MilliSeconds);
+        http.query(query);
+    }
+
     TEST_CASE("Execute sets parameters", "[HttpTest]")
     {
         auto http = createHttp();
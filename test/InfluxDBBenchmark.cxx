@@ -0,0 +1,161 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InfluxDB/InfluxDB.h"
+#include "InfluxDB/ArenaPoint.h"
+#include "InfluxDB/CoarseClock.h"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <algorithm>
+#include <memory_resource>
+#include <random>
+
+namespace influxdb::test
+{
+    namespace
+    {
+        struct NullTransport : public Transport
+        {
+            void send(std::string&& lineProtocol) override
+            {
+                bytes += lineProtocol.size();
+            }
+
+            std::size_t bytes{0};
+        };
+
+        // Interleaved series with tags added in varying order
+        std::vector<Point> pointsOf(std::size_t count, std::size_t series)
+        {
+            std::mt19937 random{42};
+            std::vector<Point> points;
+            points.reserve(count);
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const auto id = std::to_string(random() % series);
+                std::vector<std::pair<std::string, std::string>> tags{{"host", "host-" + id}, {"region", "eu-west"}, {"service", "svc-" + id}};
+                std::shuffle(tags.begin(), tags.end(), random);
+
+                Point point{"cpu"};
+                for (const auto& [key, value] : tags)
+                {
+                    point.addTag(key, value);
+                }
+                points.push_back(point.addField("usage", 0.5).addField("count", static_cast<long long int>(i)));
+            }
+            return points;
+        }
+
+        std::size_t writeBatch(bool seriesOrdering, const std::vector<Point>& points)
+        {
+            auto transport = std::make_unique<NullTransport>();
+            const auto* sent = transport.get();
+
+            InfluxDB db{std::move(transport)};
+            db.batchOf(points.size() + 1);
+            db.setSeriesOrdering(seriesOrdering);
+            db.write(std::vector<Point>{points});
+            db.flushBatch();
+            return sent->bytes;
+        }
+    }
+
+
+    TEST_CASE("Batch series ordering", "[.][benchmark]")
+    {
+        const auto points = pointsOf(5000, 100);
+
+        BENCHMARK("arrival order")
+        {
+            return writeBatch(false, points);
+        };
+
+        BENCHMARK("series order")
+        {
+            return writeBatch(true, points);
+        };
+    }
+
+    TEST_CASE("Point construction", "[.][benchmark]")
+    {
+        constexpr std::size_t count{10000};
+
+        BENCHMARK("default resource")
+        {
+            std::vector<Point> points;
+            points.reserve(count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                points.push_back(Point{"cpu_utilization_percent"}.addTag("hostname", "server-0042.example.com").addField("usage_user", 0.5));
+            }
+            return points.size();
+        };
+
+        BENCHMARK("monotonic arena")
+        {
+            std::pmr::monotonic_buffer_resource arena{count * 512};
+            std::vector<ArenaPoint> points;
+            points.reserve(count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                points.push_back(ArenaPoint{"cpu_utilization_percent", &arena}.addTag("hostname", "server-0042.example.com").addField("usage_user", 0.5));
+            }
+            return points.size();
+        };
+    }
+
+    TEST_CASE("Point timestamp", "[.][benchmark]")
+    {
+        BENCHMARK("system clock")
+        {
+            return Point{"cpu"}.getTimestamp();
+        };
+
+        Point::setClock(std::make_shared<const CoarseClock>(std::chrono::milliseconds{1}));
+
+        BENCHMARK("coarse clock")
+        {
+            return Point{"cpu"}.getTimestamp();
+        };
+
+        Point::setClock(nullptr);
+    }
+
+    TEST_CASE("Typed point write", "[.][benchmark]")
+    {
+        using Cpu = TypedPoint<"cpu", Tags<"host", "region">, Fields<Field<"usage", double>, Field<"procs", std::int64_t>>>;
+
+        const Point::TimePoint timestamp{std::chrono::seconds{1700000000}};
+        InfluxDB db{std::make_unique<NullTransport>()};
+
+        BENCHMARK("point")
+        {
+            db.write(Point{"cpu", timestamp}.addTag("host", "host-1").addTag("region", "eu-west").addField("usage", 0.5).addField("procs", 12LL));
+        };
+
+        BENCHMARK("typed point")
+        {
+            db.write(Cpu{{"host-1", "eu-west"}, {0.5, 12}, timestamp});
+        };
+    }
+}
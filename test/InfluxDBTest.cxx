@@ -21,6 +21,7 @@
 // SOFTWARE.
 
 #include "InfluxDB/InfluxDB.h"
+#include "InfluxDB/ArenaPoint.h"
 #include "InfluxDB/InfluxDBException.h"
 #include "mock/TransportMock.h"
 #include <catch2/catch_test_macros.hpp>
@@ -31,6 +32,21 @@ namespace influxdb::test
     namespace
     {
         constexpr std::chrono::time_point<std::chrono::system_clock> ignoreTimestamp(std::chrono::milliseconds(4567));
+
+        struct RecordingTracer : public Tracer
+        {
+            void begin(TraceSpan span) override
+            {
+                events.push_back("begin " + std::string{toString(span)});
+            }
+
+            void end(TraceSpan span) override
+            {
+                events.push_back("end " + std::string{toString(span)});
+            }
+
+            std::vector<std::string> events;
+        };
     }
 
     TEST_CASE("Ctor throws on nullptr transport", "[InfluxDBTest]")
@@ -143,6 +159,27 @@ namespace influxdb::test
         }
     }
 
+    TEST_CASE("Flush batch clears batch if transmission fails", "[InfluxDBTest]")
+    {
+        using trompeloeil::_;
+
+        auto mock = std::make_shared<TransportMock>();
+
+        InfluxDB db{std::make_unique<TransportAdapter>(mock)};
+        db.batchOf(300);
+        db.write(Point{"x"}.setTimestamp(ignoreTimestamp));
+
+        {
+            REQUIRE_CALL(*mock, send(_)).THROW(InfluxDBException{"Intentional"});
+            CHECK_THROWS_AS(db.flushBatch(), InfluxDBException);
+        }
+        CHECK(db.batchSize() == 0);
+
+        db.write(Point{"y"}.setTimestamp(ignoreTimestamp));
+        REQUIRE_CALL(*mock, send("y 4567000000"));
+        db.flushBatch();
+    }
+
     TEST_CASE("Flush batch does nothing if batch disabled", "[InfluxDBTest]")
     {
         auto mock = std::make_shared<TransportMock>();
@@ -168,6 +205,173 @@ namespace influxdb::test
         CHECK(db.batchSize() == 0);
     }
 
+    TEST_CASE("Batch coalescing merges points of same series and timestamp", "[InfluxDBTest]")
+    {
+        auto mock = std::make_shared<TransportMock>();
+
+        InfluxDB db{std::make_unique<TransportAdapter>(mock)};
+        db.batchOf(10);
+        db.setBatchCoalescing(true);
+        db.write(Point{"x"}.addTag("a", "1").addTag("b", "2").addField("f0", 1).addField("f1", 1).setTimestamp(ignoreTimestamp));
+        db.write(Point{"x"}.addTag("a", "1").addField("f0", 2).setTimestamp(ignoreTimestamp));
+        db.write(Point{"x"}.addTag("b", "2").addTag("a", "1").addField("f0", 3).setTimestamp(ignoreTimestamp));
+        db.write(Point{"x"}.addTag("a", "1").addTag("b", "2").addField("f0", 4).setTimestamp(ignoreTimestamp + std::chrono::seconds{1}));
+        CHECK(db.batchSize() == 3);
+
+        REQUIRE_CALL(*mock, send("x,b=2,a=1 f0=3i,f1=1i 4567000000\n"
+                                 "x,a=1 f0=2i 4567000000\n"
+                                 "x,a=1,b=2 f0=4i 5567000000"));
+        db.flushBatch();
+    }
+
+    TEST_CASE("Batch coalescing keeps series with ambiguous tags apart", "[InfluxDBTest]")
+    {
+        auto mock = std::make_shared<TransportMock>();
+
+        InfluxDB db{std::make_unique<TransportAdapter>(mock)};
+        db.batchOf(10);
+        db.setBatchCoalescing(true);
+        db.write(Point{"x"}.addTag("a=b", "c").addField("f0", 1).setTimestamp(ignoreTimestamp));
+        db.write(Point{"x"}.addTag("a", "b=c").addField("f0", 2).setTimestamp(ignoreTimestamp));
+        CHECK(db.batchSize() == 2);
+    }
+
+    TEST_CASE("Batch coalescing starts over after flush", "[InfluxDBTest]")
+    {
+        auto mock = std::make_shared<TransportMock>();
+
+        InfluxDB db{std::make_unique<TransportAdapter>(mock)};
+        db.batchOf(10);
+        db.setBatchCoalescing(true);
+        db.write(Point{"x"}.addField("f0", 1).setTimestamp(ignoreTimestamp));
+        db.clearBatch();
+        db.write(Point{"x"}.addField("f0", 2).setTimestamp(ignoreTimestamp));
+        db.write(Point{"x"}.addField("f0", 3).setTimestamp(ignoreTimestamp));
+
+        REQUIRE_CALL(*mock, send("x f0=3i 4567000000"));
+        db.flushBatch();
+    }
+
+    TEST_CASE("Series ordering sorts tags and groups batch by series", "[InfluxDBTest]")
+    {
+        auto mock = std::make_shared<TransportMock>();
+
+        InfluxDB db{std::make_unique<TransportAdapter>(mock)};
+        db.batchOf(10);
+        db.setSeriesOrdering(true);
+        db.write({Point{"y"}.addTag("b", "1").addTag("a", "1").addField("f0", 0).setTimestamp(ignoreTimestamp),
+                  Point{"x"}.addTag("a", "2").addField("f0", 1).setTimestamp(ignoreTimestamp),
+                  Point{"y"}.addTag("a", "1").addTag("b", "1").addField("f0", 2).setTimestamp(ignoreTimestamp),
+                  Point{"x"}.addTag("a", "1").addField("f0", 3).setTimestamp(ignoreTimestamp)});
+
+        REQUIRE_CALL(*mock, send("x,a=1 f0=3i 4567000000\n"
+                                 "x,a=2 f0=1i 4567000000\n"
+                                 "y,a=1,b=1 f0=0i 4567000000\n"
+                                 "y,a=1,b=1 f0=2i 4567000000"));
+        db.flushBatch();
+    }
+
+    TEST_CASE("Write transmits typed point", "[InfluxDBTest]")
+    {
+        using Typed = TypedPoint<"p", Tags<"a">, Fields<Field<"f0", int>>>;
+
+        auto mock = std::make_shared<TransportMock>();
+        REQUIRE_CALL(*mock, send("p,g=0,a=1 f0=71i 4567000000"));
+
+        InfluxDB db{std::make_unique<TransportAdapter>(mock)};
+        db.addGlobalTag("g", "0");
+        db.write(Typed{{"1"}, {71}, ignoreTimestamp});
+    }
+
+    TEST_CASE("Write with batch enabled adds typed point to batch", "[InfluxDBTest]")
+    {
+        using Typed = TypedPoint<"t", Tags<>, Fields<Field<"f0", int>>>;
+
+        auto mock = std::make_shared<TransportMock>();
+        REQUIRE_CALL(*mock, send("p f0=0i 4567000000\nt f0=1i 4567000000\np f0=2i 4567000000"));
+
+        InfluxDB db{std::make_unique<TransportAdapter>(mock)};
+        db.batchOf(3);
+        db.write(Point{"p"}.addField("f0", 0).setTimestamp(ignoreTimestamp));
+        db.write(Typed{{}, {1}, ignoreTimestamp});
+        CHECK(db.batchSize() == 2);
+        db.write(Point{"p"}.addField("f0", 2).setTimestamp(ignoreTimestamp));
+        CHECK(db.batchSize() == 0);
+    }
+
+    TEST_CASE("Batch coalescing merges typed points", "[InfluxDBTest]")
+    {
+        using Typed = TypedPoint<"p", Tags<"a">, Fields<Field<"f1", int>>>;
+
+        auto mock = std::make_shared<TransportMock>();
+        REQUIRE_CALL(*mock, send("p,a=1 f1=1i,f0=0i 4567000000"));
+
+        InfluxDB db{std::make_unique<TransportAdapter>(mock)};
+        db.batchOf(10);
+        db.setBatchCoalescing(true);
+        db.write(Point{"p"}.addTag("a", "1").addField("f0", 0).setTimestamp(ignoreTimestamp));
+        db.write(Typed{{"1"}, {1}, ignoreTimestamp});
+        CHECK(db.batchSize() == 1);
+        db.flushBatch();
+    }
+
+    TEST_CASE("Clear batch clears typed points", "[InfluxDBTest]")
+    {
+        using Typed = TypedPoint<"t", Tags<>, Fields<Field<"f0", int>>>;
+
+        auto mock = std::make_shared<TransportMock>();
+        REQUIRE_CALL(*mock, send("t f0=1i 4567000000"));
+
+        InfluxDB db{std::make_unique<TransportAdapter>(mock)};
+        db.batchOf(10);
+        db.write(Typed{{}, {0}, ignoreTimestamp});
+        db.clearBatch();
+        CHECK(db.batchSize() == 0);
+        db.write(Typed{{}, {1}, ignoreTimestamp});
+        db.flushBatch();
+    }
+
+    TEST_CASE("Write transmits arena point", "[InfluxDBTest]")
+    {
+        auto mock = std::make_shared<TransportMock>();
+        REQUIRE_CALL(*mock, send("p,g=0,a=1 f0=71i 4567000000"));
+
+        std::pmr::monotonic_buffer_resource arena;
+        InfluxDB db{std::make_unique<TransportAdapter>(mock)};
+        db.addGlobalTag("g", "0");
+        db.write(ArenaPoint{"p", ignoreTimestamp, &arena}.addTag("a", "1").addField("f0", 71));
+    }
+
+    TEST_CASE("Write with batch enabled adds arena point to batch", "[InfluxDBTest]")
+    {
+        auto mock = std::make_shared<TransportMock>();
+        REQUIRE_CALL(*mock, send("p f0=0i 4567000000\nt f0=1i 4567000000"));
+
+        InfluxDB db{std::make_unique<TransportAdapter>(mock)};
+        db.batchOf(2);
+        db.write(Point{"p"}.addField("f0", 0).setTimestamp(ignoreTimestamp));
+        {
+            std::pmr::monotonic_buffer_resource arena;
+            db.write(ArenaPoint{"t", ignoreTimestamp, &arena}.addField("f0", 1));
+        }
+        CHECK(db.batchSize() == 0);
+    }
+
+    TEST_CASE("Batch coalescing merges arena points", "[InfluxDBTest]")
+    {
+        auto mock = std::make_shared<TransportMock>();
+        REQUIRE_CALL(*mock, send("p,a=1 f1=1i,f0=0i 4567000000"));
+
+        std::pmr::monotonic_buffer_resource arena;
+        InfluxDB db{std::make_unique<TransportAdapter>(mock)};
+        db.batchOf(10);
+        db.setBatchCoalescing(true);
+        db.write(Point{"p"}.addTag("a", "1").addField("f0", 0).setTimestamp(ignoreTimestamp));
+        db.write(ArenaPoint{"p", ignoreTimestamp, &arena}.addTag("a", "1").addField("f1", 1));
+        CHECK(db.batchSize() == 1);
+        db.flushBatch();
+    }
+
     TEST_CASE("Create database throws if unsupported by transport", "[InfluxDBTest]")
     {
         auto mock = std::make_shared<TransportMock>();
@@ -208,6 +412,15 @@ namespace influxdb::test
         db.write(Point{"p"}.addField("f", 1).setTimestamp(std::chrono::time_point<std::chrono::system_clock>{std::chrono::milliseconds{67}}));
     }
 
+    TEST_CASE("Set query epoch", "[InfluxDBTest]")
+    {
+        auto mock = std::make_shared<TransportMock>();
+        REQUIRE_CALL(*mock, setQueryEpoch(TimePrecision::MilliSeconds));
+
+        InfluxDB db{std::make_unique<TransportAdapter>(mock)};
+        db.setQueryEpoch(TimePrecision::MilliSeconds);
+    }
+
     TEST_CASE("Ping instance", "[InfluxDBTest]")
     {
         auto mock = std::make_shared<TransportMock>();
@@ -217,4 +430,141 @@ namespace influxdb::test
         CHECK(db.ping());
     }
 
+    TEST_CASE("Tracer receives spans of write", "[InfluxDBTest]")
+    {
+        using trompeloeil::_;
+        auto mock = std::make_shared<TransportMock>();
+        auto tracer = std::make_shared<RecordingTracer>();
+        ALLOW_CALL(*mock, send(_));
+
+        InfluxDB db{std::make_unique<TransportAdapter>(mock)};
+        db.setTracer(tracer);
+        db.write(Point{"p0"}.addField("f0", 0).setTimestamp(ignoreTimestamp));
+        db.batchOf(2);
+        db.write({Point{"p1"}.addField("f1", 1).setTimestamp(ignoreTimestamp),
+                  Point{"p2"}.addField("f2", 2).setTimestamp(ignoreTimestamp)});
+
+        CHECK(tracer->events == std::vector<std::string>{"begin serialize", "end serialize", "begin send", "end send",
+                                                         "begin serialize", "end serialize", "begin send", "end send"});
+    }
+
+    TEST_CASE("Tracer receives end of failed span", "[InfluxDBTest]")
+    {
+        using trompeloeil::_;
+        auto mock = std::make_shared<TransportMock>();
+        auto tracer = std::make_shared<RecordingTracer>();
+        REQUIRE_CALL(*mock, send(_)).THROW(InfluxDBException{"Intentional"});
+
+        InfluxDB db{std::make_unique<TransportAdapter>(mock)};
+        db.setTracer(tracer);
+        CHECK_THROWS_AS(db.write(Point{"p0"}.addField("f0", 0).setTimestamp(ignoreTimestamp)), InfluxDBException);
+
+        CHECK(tracer->events.back() == "end send");
+    }
+
+    TEST_CASE("Aggregator emits point per completed window", "[InfluxDBTest]")
+    {
+        auto mock = std::make_shared<TransportMock>();
+        REQUIRE_CALL(*mock, send("p,host=a f0_count=2i 4000000000"));
+
+        InfluxDB db{std::make_unique<TransportAdapter>(mock)};
+        db.setAggregator(std::make_unique<Aggregator>(std::chrono::seconds{1}, std::vector{Aggregation::Count}));
+        db.write(Point{"p"}.addTag("host", "a").addField("f0", 1).setTimestamp(ignoreTimestamp));
+        db.write(Point{"p"}.addTag("host", "a").addField("f0", 2).setTimestamp(ignoreTimestamp + std::chrono::milliseconds{100}));
+        db.write(Point{"p"}.addTag("host", "a").addField("f0", 3).setTimestamp(ignoreTimestamp + std::chrono::seconds{1}));
+    }
+
+    TEST_CASE("Flush aggregation adds open windows to batch", "[InfluxDBTest]")
+    {
+        auto mock = std::make_shared<TransportMock>();
+
+        InfluxDB db{std::make_unique<TransportAdapter>(mock)};
+        db.batchOf(10);
+        db.setAggregator(std::make_unique<Aggregator>(std::chrono::seconds{1}, std::vector{Aggregation::Count}));
+        db.write({Point{"p"}.addField("f0", 1).setTimestamp(ignoreTimestamp),
+                  Point{"p"}.addField("f0", 2).setTimestamp(ignoreTimestamp)});
+        CHECK(db.batchSize() == 0);
+
+        db.flushAggregation();
+        CHECK(db.batchSize() == 1);
+
+        REQUIRE_CALL(*mock, send("p f0_count=2i 4000000000"));
+        db.flushBatch();
+    }
+
+#ifdef INFLUXCXX_WITH_METRICS
+    TEST_CASE("Metrics count written points and transmits", "[InfluxDBTest]")
+    {
+        using trompeloeil::_;
+        auto mock = std::make_shared<TransportMock>();
+        ALLOW_CALL(*mock, send(_));
+
+        InfluxDB db{std::make_unique<TransportAdapter>(mock)};
+        db.write(Point{"p0"}.addField("f0", 0).setTimestamp(ignoreTimestamp));
+        db.batchOf(2);
+        db.write({Point{"p1"}.addField("f1", 1).setTimestamp(ignoreTimestamp),
+                  Point{"p2"}.addField("f2", 2).setTimestamp(ignoreTimestamp)});
+
+        const auto metrics = db.metrics();
+        CHECK(metrics.pointsWritten == 3);
+        CHECK(metrics.bytesSerialized == std::string{"p0 f0=0i 4567000000"}.size() * 3 + 1);
+        CHECK(metrics.batchesFlushed == 1);
+        CHECK(metrics.batchedPoints == 2);
+        CHECK(metrics.transmits == 2);
+        CHECK(metrics.transmitErrors == 0);
+    }
+
+    TEST_CASE("Metrics count failed transmits", "[InfluxDBTest]")
+    {
+        using trompeloeil::_;
+        auto mock = std::make_shared<TransportMock>();
+        REQUIRE_CALL(*mock, send(_)).THROW(InfluxDBException{"Intentional"});
+
+        InfluxDB db{std::make_unique<TransportAdapter>(mock)};
+        CHECK_THROWS_AS(db.write(Point{"p0"}.addField("f0", 0).setTimestamp(ignoreTimestamp)), InfluxDBException);
+
+        const auto metrics = db.metrics();
+        CHECK(metrics.transmits == 1);
+        CHECK(metrics.transmitErrors == 1);
+        CHECK(metrics.pointsDropped == 1);
+    }
+
+    TEST_CASE("Self monitoring writes metrics point", "[InfluxDBTest]")
+    {
+        using trompeloeil::_;
+        auto mock = std::make_shared<TransportMock>();
+        trompeloeil::sequence seq;
+        REQUIRE_CALL(*mock, send("p0 f0=0i 4567000000")).IN_SEQUENCE(seq);
+        REQUIRE_CALL(*mock, send(_))
+            .WITH(_1.starts_with("stats,transport=mock points_written=1i,points_dropped=0i,bytes_serialized=19i,batches_flushed=0i,batched_points=0i,transmits=1i,transmit_errors=0i,"))
+            .IN_SEQUENCE(seq);
+
+        InfluxDB db{std::make_unique<TransportAdapter>(mock)};
+        db.setSelfMonitoring(std::chrono::milliseconds{0}, Point{"stats"}.addTag("transport", "mock"));
+        db.write(Point{"p0"}.addField("f0", 0).setTimestamp(ignoreTimestamp));
+    }
+
+    TEST_CASE("Self monitoring waits for interval", "[InfluxDBTest]")
+    {
+        auto mock = std::make_shared<TransportMock>();
+        REQUIRE_CALL(*mock, send("p0 f0=0i 4567000000"));
+
+        InfluxDB db{std::make_unique<TransportAdapter>(mock)};
+        db.setSelfMonitoring(std::chrono::hours{1});
+        db.write(Point{"p0"}.addField("f0", 0).setTimestamp(ignoreTimestamp));
+    }
+
+    TEST_CASE("Self monitoring point is added to batch", "[InfluxDBTest]")
+    {
+        using trompeloeil::_;
+        auto mock = std::make_shared<TransportMock>();
+        REQUIRE_CALL(*mock, send(_)).WITH(_1.starts_with("influxdb_cxx_stats points_written=0i,"));
+
+        InfluxDB db{std::make_unique<TransportAdapter>(mock)};
+        db.batchOf(10);
+        db.setSelfMonitoring(std::chrono::milliseconds{0});
+        db.flushBatch();
+    }
+#endif
+
 }
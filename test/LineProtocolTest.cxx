@@ -162,6 +162,49 @@ namespace influxdb::test
         CHECK_THAT(lineProtocol.format(point), Equals(R"(p1,a=0,b=1,c=2,pointtag=3 n=1i 54000000)"));
     }
 
+    TEST_CASE("Omits missing timestamp", "[LineProtocolTest]")
+    {
+        const auto point = Point{"p0", std::nullopt}.addTag("a", "1").addField("n", 0);
+        CHECK_THAT(withDefaults().format(point), Equals(R"(p0,a=1 n=0i)"));
+    }
+
+    TEST_CASE("Formats timestamp before epoch", "[LineProtocolTest]")
+    {
+        const auto point = Point{"p0", std::chrono::time_point<std::chrono::system_clock>{std::chrono::seconds{-15}}}.addField("n", 0);
+        const LineProtocol lineProtocol{{}, TimePrecision::MilliSeconds};
+        CHECK_THAT(lineProtocol.format(point), Equals(R"(p0 n=0i -15000)"));
+    }
+
+    TEST_CASE("Format appends to buffer", "[LineProtocolTest]")
+    {
+        std::string buffer{"p0 n=0i 54000000\n"};
+        withDefaults().formatTo(buffer, Point{"p1"}.addField("n", 1).setTimestamp(ignoreTimestamp));
+        CHECK_THAT(buffer, Equals("p0 n=0i 54000000\np1 n=1i 54000000"));
+    }
+
+    TEST_CASE("Sorts tags by key", "[LineProtocolTest]")
+    {
+        const auto point = Point{"p0"}
+                               .addField("n", 0)
+                               .addTag("c", "3")
+                               .addTag("a", "1")
+                               .addTag("b", "2")
+                               .setTimestamp(ignoreTimestamp);
+        const LineProtocol lineProtocol{{}, TimePrecision::NanoSeconds, true};
+        CHECK_THAT(lineProtocol.format(point), Equals(R"(p0,a=1,b=2,c=3 n=0i 54000000)"));
+    }
+
+    TEST_CASE("Sorts global tags with point tags", "[LineProtocolTest]")
+    {
+        const auto point = Point{"p0"}
+                               .addField("n", 0)
+                               .addTag("d", "x y")
+                               .addTag("b", "2")
+                               .setTimestamp(ignoreTimestamp);
+        const LineProtocol lineProtocol{R"(e=4,c=3\,\=,a=1)", TimePrecision::NanoSeconds, true};
+        CHECK_THAT(lineProtocol.format(point), Equals(R"(p0,a=1,b=2,c=3\,\=,d=x\ y,e=4 n=0i 54000000)"));
+    }
+
     TEST_CASE("Escapes Measurement string element", "[LineProtocolTest]")
     {
         // Measurement must escape comma and space characters
@@ -243,4 +286,30 @@ namespace influxdb::test
         const std::string expected{R"(measurement\,\ ,tag\,\=\ key=tag\,\=\ value field\,\=\ key="\"field\\value\"" 54000000)"};
         CHECK_THAT(lineProtocol.format(point), Equals(expected));
     }
+
+    TEST_CASE("Line writer formats as point", "[LineProtocolTest]")
+    {
+        const auto point = Point{"p0"}
+                               .addTag("t0", "v 0")
+                               .addField("f0", 3)
+                               .addField("f1", 1.5)
+                               .addField("f2", R"(a"b)")
+                               .addField("f3", true)
+                               .addField("f4", 7u)
+                               .setTimestamp(ignoreTimestamp);
+        const LineProtocol lineProtocol{"g=0", TimePrecision::MilliSeconds};
+
+        std::string line;
+        auto writer = lineProtocol.writerOf(line);
+        writer.measurement("p0");
+        writer.tag("t0", "v 0");
+        writer.tag("t1", "");
+        writer.field("f0", 3LL);
+        writer.field("f1", 1.5);
+        writer.field("f2", R"(a"b)");
+        writer.field("f3", true);
+        writer.field("f4", 7ULL);
+        writer.timestamp(ignoreTimestamp);
+        CHECK_THAT(line, Equals(lineProtocol.format(point)));
+    }
 }
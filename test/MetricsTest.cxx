@@ -0,0 +1,89 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InfluxDB/Metrics.h"
+#include <catch2/catch_test_macros.hpp>
+
+namespace influxdb::test
+{
+    using namespace std::chrono_literals;
+
+    TEST_CASE("Histogram buckets are logarithmic", "[MetricsTest]")
+    {
+        CHECK(LatencyHistogram::bucketOf(0ns) == 0);
+        CHECK(LatencyHistogram::bucketOf(999ns) == 0);
+        CHECK(LatencyHistogram::bucketOf(1us) == 1);
+        CHECK(LatencyHistogram::bucketOf(2us) == 2);
+        CHECK(LatencyHistogram::bucketOf(3us) == 2);
+        CHECK(LatencyHistogram::bucketOf(1024us) == 11);
+        CHECK(LatencyHistogram::bucketOf(24h) == LatencyHistogram::bucketCount - 1);
+    }
+
+    TEST_CASE("Histogram counts recorded latencies", "[MetricsTest]")
+    {
+        LatencyHistogram histogram;
+        histogram.record(3us);
+        histogram.record(3us);
+        histogram.record(10ms);
+
+        const auto buckets = histogram.snapshot();
+        CHECK(buckets[2] == 2);
+        CHECK(buckets[LatencyHistogram::bucketOf(10ms)] == 1);
+    }
+
+    TEST_CASE("Histogram quantile returns upper bucket bound", "[MetricsTest]")
+    {
+        LatencyHistogram histogram;
+        CHECK(LatencyHistogram::quantile(histogram.snapshot(), 0.5) == 0us);
+
+        for (int i = 0; i < 99; ++i)
+        {
+            histogram.record(3us);
+        }
+        histogram.record(1ms);
+
+        const auto buckets = histogram.snapshot();
+        CHECK(LatencyHistogram::quantile(buckets, 0.5) == 4us);
+        CHECK(LatencyHistogram::quantile(buckets, 0.99) == 4us);
+        CHECK(LatencyHistogram::quantile(buckets, 1.0) == 1024us);
+    }
+
+    TEST_CASE("Metrics snapshot contains counters", "[MetricsTest]")
+    {
+        Metrics metrics;
+        metrics.addPointsWritten(3);
+        metrics.addBytesSerialized(100);
+        metrics.addBatchFlushed(3, 5us);
+        metrics.addTransmit(2us, false);
+        metrics.addTransmit(2us, true);
+
+        const auto snapshot = metrics.snapshot();
+        CHECK(snapshot.pointsWritten == 3);
+        CHECK(snapshot.bytesSerialized == 100);
+        CHECK(snapshot.batchesFlushed == 1);
+        CHECK(snapshot.batchedPoints == 3);
+        CHECK(snapshot.transmits == 2);
+        CHECK(snapshot.transmitErrors == 1);
+        CHECK(snapshot.flushLatency[3] == 1);
+        CHECK(snapshot.transmitLatency[2] == 2);
+    }
+}
@@ -44,6 +44,16 @@ namespace influxdb::test
         CHECK_THROWS_AS(internal::queryImpl(&dummy, "-ignore-"), InfluxDBException);
     }
 
+    TEST_CASE("Query statements impl throws unconditionally", "[NoBoostSupportTest]")
+    {
+        CHECK_THROWS_AS(internal::queryStatementsImpl(&dummy, "-ignore-"), InfluxDBException);
+    }
+
+    TEST_CASE("Query stream impl throws unconditionally", "[NoBoostSupportTest]")
+    {
+        CHECK_THROWS_AS(internal::queryStreamImpl(&dummy, "-ignore-", 10, std::nullopt, []([[maybe_unused]] Point&& point) {}), InfluxDBException);
+    }
+
     TEST_CASE("With UDP throws transport unconditionally", "[NoBoostSupportTest]")
     {
         CHECK_THROWS_AS(internal::withUdpTransport(http::url{}), InfluxDBException);
@@ -152,6 +152,29 @@ namespace influxdb::test
         CHECK(point.getTimestamp() == timeStamp);
     }
 
+    TEST_CASE("Measurement constructed with time stamp", "[PointTest]")
+    {
+        const std::chrono::time_point<std::chrono::system_clock> timeStamp{std::chrono::milliseconds{1572830915}};
+        const Point point{"test", timeStamp};
+        CHECK(point.hasTimestamp());
+        CHECK(point.getTimestamp() == timeStamp);
+    }
+
+    TEST_CASE("Measurement without time stamp", "[PointTest]")
+    {
+        const Point point{"test", std::nullopt};
+        CHECK_FALSE(point.hasTimestamp());
+        CHECK(point.getTimestamp() == std::chrono::time_point<std::chrono::system_clock>{});
+    }
+
+    TEST_CASE("Measurement is time stamped by default", "[PointTest]")
+    {
+        const auto before = std::chrono::system_clock::now();
+        const Point point{"test"};
+        CHECK(point.hasTimestamp());
+        CHECK(point.getTimestamp() >= before);
+    }
+
     TEST_CASE("Float field precision can be adjusted", "[PointTest]")
     {
         Point::floatsPrecision = 3;
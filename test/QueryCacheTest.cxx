@@ -0,0 +1,185 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InfluxDB/QueryCache.h"
+#include <catch2/catch_test_macros.hpp>
+#include <future>
+#include <stdexcept>
+#include <thread>
+
+namespace influxdb::test
+{
+    using namespace std::chrono_literals;
+
+    TEST_CASE("Cache executes query on miss", "[QueryCacheTest]")
+    {
+        QueryCache cache{1024, 1h};
+        CHECK(cache.get("q", []
+                        { return std::string{"response"}; }) == "response");
+        CHECK(cache.misses() == 1);
+        CHECK(cache.hits() == 0);
+        CHECK(cache.bytes() == 9);
+    }
+
+    TEST_CASE("Cache returns cached response on hit", "[QueryCacheTest]")
+    {
+        QueryCache cache{1024, 1h};
+        std::size_t executions{0};
+        const auto execute = [&executions]
+        {
+            ++executions;
+            return std::string{"response"};
+        };
+
+        cache.get("q", execute);
+        CHECK(cache.get("q", execute) == "response");
+        CHECK(executions == 1);
+        CHECK(cache.hits() == 1);
+        CHECK(cache.misses() == 1);
+    }
+
+    TEST_CASE("Cache executes expired query again", "[QueryCacheTest]")
+    {
+        QueryCache cache{1024, 1ms};
+        std::size_t executions{0};
+        const auto execute = [&executions]
+        {
+            return std::to_string(++executions);
+        };
+
+        cache.get("q", execute);
+        std::this_thread::sleep_for(5ms);
+        CHECK(cache.get("q", execute) == "2");
+        CHECK(cache.misses() == 2);
+    }
+
+    TEST_CASE("Cache evicts least recently used entries if budget exceeded", "[QueryCacheTest]")
+    {
+        QueryCache cache{20, 1h};
+        std::size_t executions{0};
+        const auto execute = [&executions]
+        {
+            ++executions;
+            return std::string{"123456789"};
+        };
+
+        cache.get("a", execute);
+        cache.get("b", execute);
+        cache.get("a", execute);
+        cache.get("c", execute);
+        CHECK(executions == 3);
+        CHECK(cache.bytes() == 20);
+
+        cache.get("a", execute);
+        CHECK(executions == 3);
+        cache.get("b", execute);
+        CHECK(executions == 4);
+    }
+
+    TEST_CASE("Cache does not store responses exceeding budget", "[QueryCacheTest]")
+    {
+        QueryCache cache{4, 1h};
+        cache.get("q", []
+                  { return std::string{"response"}; });
+        CHECK(cache.bytes() == 0);
+    }
+
+    TEST_CASE("Cache does not store failed queries", "[QueryCacheTest]")
+    {
+        QueryCache cache{1024, 1h};
+        CHECK_THROWS_AS(cache.get("q", []() -> std::string
+                                  { throw std::runtime_error{"Intentional"}; }),
+                        std::runtime_error);
+        CHECK(cache.get("q", []
+                        { return std::string{"response"}; }) == "response");
+        CHECK(cache.misses() == 2);
+    }
+
+    TEST_CASE("Cache clear removes entries", "[QueryCacheTest]")
+    {
+        QueryCache cache{1024, 1h};
+        cache.get("q", []
+                  { return std::string{"response"}; });
+        cache.clear();
+        CHECK(cache.bytes() == 0);
+        cache.get("q", []
+                  { return std::string{"response"}; });
+        CHECK(cache.misses() == 2);
+    }
+
+    TEST_CASE("Cache shares execution of concurrent identical queries", "[QueryCacheTest]")
+    {
+        QueryCache cache{1024, 1h};
+        std::promise<void> release;
+        auto released = release.get_future().share();
+        std::size_t executions{0};
+
+        const auto blockingQuery = [&executions, released]
+        {
+            ++executions;
+            released.wait();
+            return std::string{"response"};
+        };
+        const auto unexpectedQuery = []
+        {
+            return std::string{"unexpected"};
+        };
+
+        auto first = std::async(std::launch::async, [&cache, &blockingQuery]
+                                { return cache.get("q", blockingQuery); });
+        while (cache.misses() == 0)
+        {
+            std::this_thread::yield();
+        }
+
+        auto second = std::async(std::launch::async, [&cache, &unexpectedQuery]
+                                 { return cache.get("q", unexpectedQuery); });
+        while (cache.hits() == 0)
+        {
+            std::this_thread::yield();
+        }
+        release.set_value();
+
+        CHECK(first.get() == "response");
+        CHECK(second.get() == "response");
+        CHECK(executions == 1);
+    }
+
+    TEST_CASE("Cache accepts single read-only statements", "[QueryCacheTest]")
+    {
+        CHECK(QueryCache::isCacheable("SELECT * FROM cpu"));
+        CHECK(QueryCache::isCacheable("  select value from cpu where host = 'a;b';"));
+        CHECK(QueryCache::isCacheable("SELECT \"into\" FROM cpu WHERE note = 'copy INTO x'"));
+        CHECK(QueryCache::isCacheable("SHOW DATABASES"));
+    }
+
+    TEST_CASE("Cache bypasses statements modifying the database", "[QueryCacheTest]")
+    {
+        CHECK_FALSE(QueryCache::isCacheable("SELECT * INTO cpu_copy FROM cpu"));
+        CHECK_FALSE(QueryCache::isCacheable("select mean(value) into downsampled from cpu group by time(1h)"));
+        CHECK_FALSE(QueryCache::isCacheable("DROP MEASUREMENT cpu"));
+        CHECK_FALSE(QueryCache::isCacheable("DELETE FROM cpu"));
+        CHECK_FALSE(QueryCache::isCacheable("SELECT * FROM cpu; DROP MEASUREMENT cpu"));
+        CHECK_FALSE(QueryCache::isCacheable("SELECT * FROM cpu; SELECT * FROM mem"));
+        CHECK_FALSE(QueryCache::isCacheable(""));
+    }
+}
@@ -0,0 +1,71 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InfluxDB/RetryPolicy.h"
+#include <catch2/catch_test_macros.hpp>
+
+namespace influxdb::test
+{
+    using namespace std::chrono_literals;
+
+    TEST_CASE("Default policy does not retry", "[RetryPolicyTest]")
+    {
+        const RetryPolicy policy{};
+        CHECK(policy.maxAttempts == 1);
+    }
+
+    TEST_CASE("Backoff grows exponentially", "[RetryPolicyTest]")
+    {
+        const RetryPolicy policy{5, 100ms, 10s, 2.0, false};
+        CHECK(policy.backoff(1) == 100ms);
+        CHECK(policy.backoff(2) == 200ms);
+        CHECK(policy.backoff(3) == 400ms);
+    }
+
+    TEST_CASE("Backoff is limited to maximum", "[RetryPolicyTest]")
+    {
+        const RetryPolicy policy{10, 100ms, 300ms, 2.0, false};
+        CHECK(policy.backoff(3) == 300ms);
+        CHECK(policy.backoff(50) == 300ms);
+    }
+
+    TEST_CASE("Backoff with jitter stays within bounds", "[RetryPolicyTest]")
+    {
+        const RetryPolicy policy{5, 100ms, 10s, 2.0, true};
+
+        for (int i = 0; i < 100; ++i)
+        {
+            const auto delay = policy.backoff(2);
+            CHECK(delay >= 0ms);
+            CHECK(delay <= 200ms);
+        }
+    }
+
+    TEST_CASE("Transient statuses are retryable", "[RetryPolicyTest]")
+    {
+        CHECK(RetryPolicy::isRetryableStatus(429));
+        CHECK(RetryPolicy::isRetryableStatus(503));
+        CHECK_FALSE(RetryPolicy::isRetryableStatus(400));
+        CHECK_FALSE(RetryPolicy::isRetryableStatus(401));
+        CHECK_FALSE(RetryPolicy::isRetryableStatus(404));
+    }
+}
@@ -0,0 +1,228 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InfluxDB/Router.h"
+#include "InfluxDB/InfluxDBException.h"
+#include "mock/RecordingTransport.h"
+#include <catch2/catch_test_macros.hpp>
+#include <set>
+
+namespace influxdb::test
+{
+    using influxdb::transports::Router;
+
+    TEST_CASE("Router throws on missing backends", "[RouterTest]")
+    {
+        CHECK_THROWS_AS(Router{std::vector<std::unique_ptr<Transport>>{}}, InfluxDBException);
+
+        std::vector<std::unique_ptr<Transport>> backends;
+        backends.push_back(nullptr);
+        CHECK_THROWS_AS(Router{std::move(backends)}, InfluxDBException);
+    }
+
+    TEST_CASE("Router throws on invalid backend names", "[RouterTest]")
+    {
+        std::vector<RecordingTransport> transports(2);
+
+        std::vector<RouterBackend> unnamed;
+        unnamed.push_back(RouterBackend{"", std::make_unique<TransportRef>(transports[0])});
+        CHECK_THROWS_AS(Router{std::move(unnamed)}, InfluxDBException);
+
+        std::vector<RouterBackend> duplicates;
+        duplicates.push_back(RouterBackend{"a", std::make_unique<TransportRef>(transports[0])});
+        duplicates.push_back(RouterBackend{"a", std::make_unique<TransportRef>(transports[1])});
+        CHECK_THROWS_AS(Router{std::move(duplicates)}, InfluxDBException);
+    }
+
+    TEST_CASE("Router keeps series of named backends if another is removed", "[RouterTest]")
+    {
+        std::vector<RecordingTransport> transports(3);
+        const auto routerOf = [&transports](const std::vector<std::string>& names)
+        {
+            std::vector<RouterBackend> backends;
+            for (std::size_t i = 0; i < names.size(); ++i)
+            {
+                backends.push_back(RouterBackend{names[i], std::make_unique<TransportRef>(transports[i])});
+            }
+            return Router{std::move(backends)};
+        };
+        const std::vector<std::string> all{"node-a", "node-b", "node-c"};
+        const std::vector<std::string> remaining{"node-a", "node-c"};
+        const auto before = routerOf(all);
+        const auto after = routerOf(remaining);
+
+        std::size_t moved{0};
+        for (int i = 0; i < 1000; ++i)
+        {
+            const auto line = "cpu,host=h" + std::to_string(i) + " value=1";
+            const auto& name = all[before.backendOf(line)];
+
+            if (name != "node-b")
+            {
+                CHECK(remaining[after.backendOf(line)] == name);
+            }
+            else
+            {
+                ++moved;
+            }
+        }
+        CHECK(moved > 0);
+    }
+
+    TEST_CASE("Router distributes round robin", "[RouterTest]")
+    {
+        std::vector<RecordingTransport> transports(2);
+        Router router{transportsOf(transports), RoutingStrategy::RoundRobin};
+
+        router.send("p0 f=0i\np1 f=1i\np2 f=2i");
+        router.send("p3 f=3i");
+
+        CHECK(transports[0].sent() == std::vector<std::string>{"p0 f=0i\np2 f=2i"});
+        CHECK(transports[1].sent() == std::vector<std::string>{"p1 f=1i", "p3 f=3i"});
+    }
+
+    TEST_CASE("Router sends series to the same backend", "[RouterTest]")
+    {
+        std::vector<RecordingTransport> transports(4);
+        Router router{transportsOf(transports)};
+
+        for (int i = 0; i < 100; ++i)
+        {
+            router.send("cpu,host=h" + std::to_string(i % 10) + " value=" + std::to_string(i) + "i");
+        }
+
+        std::set<std::string> series;
+        std::size_t used{0};
+        for (auto& transport : transports)
+        {
+            std::set<std::string> own;
+            for (const auto& message : transport.sent())
+            {
+                own.insert(message.substr(0, message.find(' ')));
+            }
+            for (const auto& s : own)
+            {
+                CHECK(series.insert(s).second);
+            }
+            used += own.empty() ? 0 : 1;
+        }
+        CHECK(series.size() == 10);
+        CHECK(used > 1);
+    }
+
+    TEST_CASE("Router hashes measurement only", "[RouterTest]")
+    {
+        std::vector<RecordingTransport> transports(3);
+        const Router router{transportsOf(transports), RoutingStrategy::MeasurementHash};
+
+        CHECK(router.backendOf("cpu,host=a value=1") == router.backendOf("cpu,host=b value=1"));
+        CHECK(router.backendOf("cpu value=1") == router.backendOf("cpu,host=b value=1"));
+    }
+
+    TEST_CASE("Router hashes escaped delimiters", "[RouterTest]")
+    {
+        std::vector<RecordingTransport> transports(3);
+        const Router router{transportsOf(transports), RoutingStrategy::MeasurementHash};
+
+        CHECK(router.backendOf(R"(cpu\ load,host=a value=1)") == router.backendOf(R"(cpu\ load value=2)"));
+    }
+
+    TEST_CASE("Router sends to all backends if one fails", "[RouterTest]")
+    {
+        std::vector<RecordingTransport> transports(2);
+        transports[0].reachable = false;
+        Router router{transportsOf(transports), RoutingStrategy::RoundRobin};
+
+        CHECK_THROWS_AS(router.send("p0 f=0i\np1 f=1i"), InfluxDBException);
+        CHECK(transports[1].sent() == std::vector<std::string>{"p1 f=1i"});
+    }
+
+    TEST_CASE("Router reports points of failed backends", "[RouterTest]")
+    {
+        std::vector<RecordingTransport> transports(3);
+        transports[0].reachable = false;
+        transports[2].reachable = false;
+        Router router{transportsOf(transports), RoutingStrategy::RoundRobin};
+
+        std::string undelivered;
+        try
+        {
+            router.send("p0 f=0i\np1 f=1i\np2 f=2i\np3 f=3i");
+        }
+        catch (const PartialSendException& e)
+        {
+            undelivered = e.undelivered();
+        }
+        CHECK(undelivered == "p0 f=0i\np3 f=3i\np2 f=2i");
+        CHECK(transports[1].sent() == std::vector<std::string>{"p1 f=1i"});
+    }
+
+    TEST_CASE("Router rethrows failure if all backends fail", "[RouterTest]")
+    {
+        std::vector<RecordingTransport> transports(2);
+        transports[0].reachable = false;
+        transports[1].reachable = false;
+        Router router{transportsOf(transports), RoutingStrategy::RoundRobin};
+
+        bool isPartial{false};
+        try
+        {
+            router.send("p0 f=0i\np1 f=1i");
+        }
+        catch (const PartialSendException&)
+        {
+            isPartial = true;
+        }
+        catch (const InfluxDBException&)
+        {
+        }
+        CHECK_FALSE(isPartial);
+    }
+
+    TEST_CASE("Router applies settings to all backends", "[RouterTest]")
+    {
+        std::vector<RecordingTransport> transports(2);
+        Router router{transportsOf(transports)};
+
+        router.setTimePrecision(TimePrecision::Seconds);
+        CHECK(transports[0].timePrecision == TimePrecision::Seconds);
+        CHECK(transports[1].timePrecision == TimePrecision::Seconds);
+    }
+
+    TEST_CASE("Router ping requires all backends", "[RouterTest]")
+    {
+        std::vector<RecordingTransport> transports(2);
+        Router router{transportsOf(transports)};
+
+        CHECK(router.ping());
+        transports[1].reachable = false;
+        CHECK_FALSE(router.ping());
+    }
+
+    TEST_CASE("Router does not support queries", "[RouterTest]")
+    {
+        std::vector<RecordingTransport> transports(1);
+        Router router{transportsOf(transports)};
+
+        CHECK_THROWS_AS(router.query("SELECT * FROM cpu"), InfluxDBException);
+    }
+}
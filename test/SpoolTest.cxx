@@ -0,0 +1,287 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InfluxDB/Spool.h"
+#include "InfluxDB/InfluxDBException.h"
+#include "InfluxDB/Router.h"
+#include "mock/RecordingTransport.h"
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace influxdb::test
+{
+    using namespace std::chrono_literals;
+    using influxdb::transports::Spool;
+
+    namespace
+    {
+        struct SpoolDirectory
+        {
+            SpoolDirectory()
+                : path(std::filesystem::temp_directory_path() / ("influxdb-spool-test-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count())))
+            {
+            }
+
+            ~SpoolDirectory()
+            {
+                std::filesystem::remove_all(path);
+            }
+
+            std::size_t segments() const
+            {
+                const std::filesystem::directory_iterator entries{path};
+                return static_cast<std::size_t>(std::count_if(begin(entries), end(entries), [](const auto& entry)
+                                                               { return entry.path().extension() == ".spool"; }));
+            }
+
+            std::filesystem::path path;
+        };
+
+        const SpoolOptions testOptions{1024, 64, 1ms};
+
+        bool waitUntilReplayed(const Spool& spool)
+        {
+            for (int i = 0; i < 2000 && spool.pendingBytes() > 0; ++i)
+            {
+                std::this_thread::sleep_for(1ms);
+            }
+            return spool.pendingBytes() == 0;
+        }
+    }
+
+
+    TEST_CASE("Spool throws on nullptr transport", "[SpoolTest]")
+    {
+        SpoolDirectory dir;
+        CHECK_THROWS_AS(Spool(nullptr, dir.path), InfluxDBException);
+    }
+
+    TEST_CASE("Spool sends directly if nothing pending", "[SpoolTest]")
+    {
+        SpoolDirectory dir;
+        RecordingTransport transport;
+        Spool spool{std::make_unique<TransportRef>(transport), dir.path, testOptions};
+
+        spool.send("m0 f=1i");
+        CHECK(transport.sent() == std::vector<std::string>{"m0 f=1i"});
+        CHECK(spool.pendingBytes() == 0);
+        CHECK(dir.segments() == 0);
+    }
+
+    TEST_CASE("Spool replays failed messages in order", "[SpoolTest]")
+    {
+        SpoolDirectory dir;
+        RecordingTransport transport;
+        Spool spool{std::make_unique<TransportRef>(transport), dir.path, testOptions};
+
+        transport.reachable = false;
+        spool.send("m0 f=1i");
+        spool.send("m1 f=2i");
+        CHECK(spool.pendingBytes() > 0);
+
+        transport.reachable = true;
+        spool.send("m2 f=3i");
+        REQUIRE(waitUntilReplayed(spool));
+        CHECK(transport.sent() == std::vector<std::string>{"m0 f=1i", "m1 f=2i", "m2 f=3i"});
+        CHECK(dir.segments() == 0);
+    }
+
+    TEST_CASE("Spool drops message rejected by reachable server", "[SpoolTest]")
+    {
+        SpoolDirectory dir;
+        RecordingTransport transport;
+        transport.rejected = "m0 f=bad";
+
+        std::mutex mutex;
+        std::vector<std::string> rejected;
+        auto options = testOptions;
+        options.onRejected = [&mutex, &rejected](std::string_view message, const std::string& error)
+        {
+            std::lock_guard lock{mutex};
+            rejected.push_back(std::string{message} + ": " + error);
+        };
+        Spool spool{std::make_unique<TransportRef>(transport), dir.path, options};
+
+        spool.send("m0 f=bad");
+        spool.send("m1 f=1i");
+        spool.send("m2 f=2i");
+        REQUIRE(waitUntilReplayed(spool));
+        CHECK(transport.sent() == std::vector<std::string>{"m1 f=1i", "m2 f=2i"});
+        CHECK(spool.evictedBytes() == 16);
+
+        // Reported after the message is removed from the spool
+        const auto isReported = [&mutex, &rejected]
+        {
+            std::lock_guard lock{mutex};
+            return !rejected.empty();
+        };
+        for (int i = 0; i < 1000 && !isReported(); ++i)
+        {
+            std::this_thread::sleep_for(1ms);
+        }
+        std::lock_guard lock{mutex};
+        CHECK(rejected == std::vector<std::string>{"m0 f=bad: Intentional"});
+    }
+
+    TEST_CASE("Spool keeps failed messages while server is unreachable", "[SpoolTest]")
+    {
+        SpoolDirectory dir;
+        RecordingTransport transport;
+        Spool spool{std::make_unique<TransportRef>(transport), dir.path, testOptions};
+
+        transport.reachable = false;
+        spool.send("m0 f=1i");
+        std::this_thread::sleep_for(50ms);
+        CHECK(spool.pendingBytes() > 0);
+        CHECK(spool.evictedBytes() == 0);
+
+        transport.reachable = true;
+        REQUIRE(waitUntilReplayed(spool));
+        CHECK(transport.sent() == std::vector<std::string>{"m0 f=1i"});
+    }
+
+    TEST_CASE("Spool replays only undelivered part of message", "[SpoolTest]")
+    {
+        SpoolDirectory dir;
+        RecordingTransport first;
+        RecordingTransport second;
+        first.reachable = false;
+
+        Spool spool{std::make_unique<transports::Router>(transportsOf(first, second), RoutingStrategy::RoundRobin), dir.path, testOptions};
+
+        spool.send("m0 f=1i\nm1 f=2i");
+        CHECK(spool.pendingBytes() > 0);
+
+        first.reachable = true;
+        REQUIRE(waitUntilReplayed(spool));
+        CHECK(first.sent() == std::vector<std::string>{"m0 f=1i"});
+        CHECK(second.sent() == std::vector<std::string>{"m1 f=2i"});
+    }
+
+    TEST_CASE("Spool replays messages of previous run", "[SpoolTest]")
+    {
+        SpoolDirectory dir;
+        RecordingTransport transport;
+
+        {
+            transport.reachable = false;
+            Spool spool{std::make_unique<TransportRef>(transport), dir.path, testOptions};
+            spool.send("m0 f=1i");
+            spool.send("m1 f=2i");
+        }
+        CHECK(dir.segments() > 0);
+
+        transport.reachable = true;
+        Spool spool{std::make_unique<TransportRef>(transport), dir.path, testOptions};
+        REQUIRE(waitUntilReplayed(spool));
+        CHECK(transport.sent() == std::vector<std::string>{"m0 f=1i", "m1 f=2i"});
+    }
+
+    TEST_CASE("Spool doesn't resend messages replayed by previous run", "[SpoolTest]")
+    {
+        SpoolDirectory dir;
+        RecordingTransport transport;
+
+        {
+            transport.reachable = false;
+            Spool spool{std::make_unique<TransportRef>(transport), dir.path, testOptions};
+            spool.send("m0 f=1i");
+            spool.send("m1 f=2i");
+            spool.send("m2 f=3i");
+        }
+
+        {
+            transport.reachable = true;
+            transport.rejected = "m2 f=3i";
+            auto options = testOptions;
+            options.maxRejections = 1000000;
+            Spool spool{std::make_unique<TransportRef>(transport), dir.path, options};
+
+            for (int i = 0; i < 2000 && spool.pendingBytes() > 15; ++i)
+            {
+                std::this_thread::sleep_for(1ms);
+            }
+            REQUIRE(spool.pendingBytes() == 15);
+        }
+
+        transport.rejected.clear();
+        Spool spool{std::make_unique<TransportRef>(transport), dir.path, testOptions};
+        CHECK(spool.pendingBytes() == 15);
+        REQUIRE(waitUntilReplayed(spool));
+        CHECK(transport.sent() == std::vector<std::string>{"m0 f=1i", "m1 f=2i", "m2 f=3i"});
+    }
+
+    TEST_CASE("Spool evicts oldest segments if size cap exceeded", "[SpoolTest]")
+    {
+        SpoolDirectory dir;
+        RecordingTransport transport;
+        Spool spool{std::make_unique<TransportRef>(transport), dir.path, SpoolOptions{100, 40, 1ms}};
+
+        transport.reachable = false;
+        for (int i = 0; i < 6; ++i)
+        {
+            spool.send("m" + std::to_string(i) + " f=1234567890i");
+        }
+        CHECK(spool.pendingBytes() <= 100);
+        CHECK(spool.evictedBytes() > 0);
+
+        transport.reachable = true;
+        REQUIRE(waitUntilReplayed(spool));
+        const auto sent = transport.sent();
+        REQUIRE_FALSE(sent.empty());
+        CHECK(sent.back() == "m5 f=1234567890i");
+        CHECK(sent.front() != "m0 f=1234567890i");
+    }
+
+    TEST_CASE("Spool skips corrupted records", "[SpoolTest]")
+    {
+        SpoolDirectory dir;
+        RecordingTransport transport;
+
+        {
+            transport.reachable = false;
+            Spool spool{std::make_unique<TransportRef>(transport), dir.path, testOptions};
+            spool.send("m0 f=1i");
+        }
+
+        for (const auto& entry : std::filesystem::directory_iterator{dir.path})
+        {
+            if (entry.path().extension() != ".spool")
+            {
+                continue;
+            }
+            std::fstream segment{entry.path(), std::ios::binary | std::ios::in | std::ios::out};
+            segment.seekp(10);
+            segment.put('X');
+        }
+
+        transport.reachable = true;
+        Spool spool{std::make_unique<TransportRef>(transport), dir.path, testOptions};
+        REQUIRE(waitUntilReplayed(spool));
+        CHECK(transport.sent().empty());
+        CHECK(spool.evictedBytes() > 0);
+    }
+}
@@ -0,0 +1,88 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InfluxDB/Tracer.h"
+#include "InfluxDB/InfluxDBException.h"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+#include <filesystem>
+#include <sstream>
+
+namespace influxdb::test
+{
+    using Catch::Matchers::ContainsSubstring;
+    using Catch::Matchers::StartsWith;
+    using Catch::Matchers::EndsWith;
+
+    namespace
+    {
+        std::string readFile(const std::filesystem::path& path)
+        {
+            std::ifstream in{path};
+            std::stringstream content;
+            content << in.rdbuf();
+            return content.str();
+        }
+    }
+
+
+    TEST_CASE("Span names", "[TracerTest]")
+    {
+        CHECK(toString(TraceSpan::Serialize) == "serialize");
+        CHECK(toString(TraceSpan::Send) == "send");
+        CHECK(toString(TraceSpan::Query) == "query");
+        CHECK(toString(TraceSpan::Decode) == "decode");
+    }
+
+    TEST_CASE("Chrome trace writer writes events", "[TracerTest]")
+    {
+        const auto path = std::filesystem::temp_directory_path() / "influxdb-cxx-tracer-test.json";
+        {
+            ChromeTraceWriter writer{path.string()};
+            writer.begin(TraceSpan::Send);
+            writer.end(TraceSpan::Send);
+        }
+
+        const auto trace = readFile(path);
+        CHECK_THAT(trace, StartsWith(R"({"traceEvents":[)"));
+        CHECK_THAT(trace, ContainsSubstring(R"({"name":"send","cat":"influxdb","ph":"B","ts":)"));
+        CHECK_THAT(trace, ContainsSubstring(R"({"name":"send","cat":"influxdb","ph":"E","ts":)"));
+        CHECK_THAT(trace, EndsWith("]}\n"));
+        std::filesystem::remove(path);
+    }
+
+    TEST_CASE("Chrome trace writer without events is valid", "[TracerTest]")
+    {
+        const auto path = std::filesystem::temp_directory_path() / "influxdb-cxx-tracer-test-empty.json";
+        {
+            ChromeTraceWriter writer{path.string()};
+        }
+
+        CHECK(readFile(path) == "{\"traceEvents\":[\n]}\n");
+        std::filesystem::remove(path);
+    }
+
+    TEST_CASE("Chrome trace writer throws if file can't be opened", "[TracerTest]")
+    {
+        CHECK_THROWS_AS(ChromeTraceWriter{"/not/existing/dir/trace.json"}, InfluxDBException);
+    }
+}
@@ -0,0 +1,114 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InfluxDB/TypedPoint.h"
+#include <catch2/catch_test_macros.hpp>
+
+namespace influxdb::test
+{
+    namespace
+    {
+        using Cpu = TypedPoint<"cpu", Tags<"host", "region">, Fields<Field<"usage", double>, Field<"procs", std::int64_t>>>;
+
+        const Point::TimePoint ignoreTimestamp{std::chrono::milliseconds{4567}};
+    }
+
+    TEST_CASE("Keys are escaped at compile time", "[TypedPointTest]")
+    {
+        STATIC_REQUIRE(internal::escapedMeasurement<"a b,c=d"> == R"(a\ b\,c=d)");
+        STATIC_REQUIRE(internal::escapedKey<"a b,c=d"> == R"(a\ b\,c\=d)");
+        STATIC_REQUIRE(internal::escapedKey<"abc"> == "abc");
+    }
+
+    TEST_CASE("Formats typed point", "[TypedPointTest]")
+    {
+        const Cpu point{{"host-1", "eu"}, {0.5, 12}, ignoreTimestamp};
+        CHECK(point.toLineProtocol() == "cpu,host=host-1,region=eu usage=0.500000000000000000,procs=12i 4567000000");
+    }
+
+    TEST_CASE("Formats typed point with precision", "[TypedPointTest]")
+    {
+        const Cpu point{{"host-1", "eu"}, {0.5, 12}, ignoreTimestamp};
+        CHECK(point.toLineProtocol(TimePrecision::MilliSeconds) == "cpu,host=host-1,region=eu usage=0.500000000000000000,procs=12i 4567");
+        CHECK(point.toLineProtocol(TimePrecision::Seconds) == "cpu,host=host-1,region=eu usage=0.500000000000000000,procs=12i 4");
+    }
+
+    TEST_CASE("Formats typed point without timestamp", "[TypedPointTest]")
+    {
+        const Cpu point{{"host-1", "eu"}, {0.5, 12}};
+        CHECK(point.toLineProtocol() == "cpu,host=host-1,region=eu usage=0.500000000000000000,procs=12i");
+    }
+
+    TEST_CASE("Typed point omits empty tags", "[TypedPointTest]")
+    {
+        const Cpu point{{"", "eu"}, {0.5, 12}, ignoreTimestamp};
+        CHECK(point.toLineProtocol() == "cpu,region=eu usage=0.500000000000000000,procs=12i 4567000000");
+    }
+
+    TEST_CASE("Typed point appends global tags", "[TypedPointTest]")
+    {
+        const Cpu point{{"host-1", "eu"}, {0.5, 12}, ignoreTimestamp};
+        std::string line{"x\n"};
+        point.formatTo(line, TimePrecision::NanoSeconds, "dc=fra");
+        CHECK(line == "x\ncpu,dc=fra,host=host-1,region=eu usage=0.500000000000000000,procs=12i 4567000000");
+    }
+
+    TEST_CASE("Typed point escapes keys and values", "[TypedPointTest]")
+    {
+        using Escaping = TypedPoint<"m e,a", Tags<"t=k">, Fields<Field<"f k", std::string>>>;
+
+        const Escaping point{{"v a,l"}, {R"(s "q" \)"}, ignoreTimestamp};
+        CHECK(point.toLineProtocol() == R"(m\ e\,a,t\=k=v\ a\,l f\ k="s \"q\" \\" 4567000000)");
+    }
+
+    TEST_CASE("Typed point formats field types", "[TypedPointTest]")
+    {
+        using Types = TypedPoint<"m", Tags<>, Fields<Field<"i", int>, Field<"u", std::uint64_t>, Field<"b", bool>, Field<"s", std::string_view>>>;
+
+        const Types point{{}, {-3, 18446744073709551615ULL, true, "x"}, ignoreTimestamp};
+        CHECK(point.toLineProtocol() == R"(m i=-3i,u=18446744073709551615u,b=true,s="x" 4567000000)");
+    }
+
+    TEST_CASE("Typed point values are accessible by key", "[TypedPointTest]")
+    {
+        Cpu point{};
+        point.tag<"host">() = "host-2";
+        point.field<"usage">() = 1.5;
+        point.field<"procs">() = 7;
+
+        CHECK(point.tag<"host">() == "host-2");
+        CHECK(point.tag<"region">().empty());
+        CHECK(std::as_const(point).field<"procs">() == 7);
+        CHECK(point.toLineProtocol() == "cpu,host=host-2 usage=1.500000000000000000,procs=7i");
+    }
+
+    TEST_CASE("Typed point converts to point", "[TypedPointTest]")
+    {
+        const Cpu typed{{"host-1", "eu"}, {0.5, 12}, ignoreTimestamp};
+        const auto point = typed.toPoint();
+
+        CHECK(point.getName() == "cpu");
+        CHECK(point.getTags() == "host=host-1,region=eu");
+        CHECK(point.getFields() == "usage=0.500000000000000000,procs=12i");
+        CHECK(point.getTimestamp() == ignoreTimestamp);
+    }
+}
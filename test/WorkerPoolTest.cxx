@@ -0,0 +1,82 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "WorkerPool.h"
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+namespace influxdb::test
+{
+    using internal::WorkerPool;
+
+    TEST_CASE("Worker pool runs task on workers", "[WorkerPoolTest]")
+    {
+        WorkerPool pool{3};
+        std::atomic<int> runs{0};
+
+        pool.run(2, [&runs]
+                 { ++runs; });
+        CHECK(runs == 2);
+
+        pool.run(5, [&runs]
+                 { ++runs; });
+        CHECK(runs == 5);
+        CHECK(pool.size() == 3);
+    }
+
+    TEST_CASE("Worker pool reuses its threads", "[WorkerPoolTest]")
+    {
+        WorkerPool pool{2};
+        std::mutex mutex;
+        std::set<std::thread::id> threads;
+        const auto recordThread = [&mutex, &threads]
+        {
+            std::lock_guard lock{mutex};
+            threads.insert(std::this_thread::get_id());
+        };
+
+        for (int i = 0; i < 10; ++i)
+        {
+            pool.run(2, recordThread);
+        }
+        CHECK(threads.size() <= 2);
+        CHECK(threads.count(std::this_thread::get_id()) == 0);
+    }
+
+    TEST_CASE("Worker pool rethrows exception of task", "[WorkerPoolTest]")
+    {
+        WorkerPool pool{2};
+
+        CHECK_THROWS_AS(pool.run(2, []
+                                 { throw std::runtime_error{"Intentional"}; }),
+                        std::runtime_error);
+
+        std::atomic<int> runs{0};
+        pool.run(2, [&runs]
+                 { ++runs; });
+        CHECK(runs == 2);
+    }
+}
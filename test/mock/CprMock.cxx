@@ -90,6 +90,21 @@ namespace cpr
         influxdb::test::sessionMock.SetVerifySsl(verify);
     }
 
+    void Session::SetHttpVersion(const HttpVersion& version)
+    {
+        influxdb::test::sessionMock.SetHttpVersion(version);
+    }
+
+    void Session::SetWriteCallback(const WriteCallback& write)
+    {
+        influxdb::test::sessionMock.SetWriteCallback(write);
+    }
+
+    void Session::SetHeaderCallback(const HeaderCallback& header)
+    {
+        influxdb::test::sessionMock.SetHeaderCallback(header);
+    }
+
     void Session::SetParameters(Parameters&& parameters)
     {
         influxdb::test::sessionMock.SetParameters(ParametersSpy::toMap(parameters));
@@ -46,6 +46,9 @@ namespace influxdb::test
         MAKE_MOCK1(SetProxies, void(cpr::Proxies&&));
         MAKE_MOCK1(SetProxyAuth, void(cpr::ProxyAuthentication&&));
         MAKE_MOCK1(SetVerifySsl, void(const cpr::VerifySsl&));
+        MAKE_MOCK1(SetHttpVersion, void(const cpr::HttpVersion&));
+        MAKE_MOCK1(SetWriteCallback, void(const cpr::WriteCallback&));
+        MAKE_MOCK1(SetHeaderCallback, void(const cpr::HeaderCallback&));
     };
 
     extern SessionMock sessionMock;
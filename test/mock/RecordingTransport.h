@@ -0,0 +1,186 @@
+// MIT License
+//
+// Copyright (c) 2020-2026 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "InfluxDB/InfluxDBException.h"
+#include "InfluxDB/Transport.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace influxdb::test
+{
+    /// Fake of a server, recording the sent messages; may be used by background threads
+    struct RecordingTransport : public Transport
+    {
+        void send(std::string&& message) override
+        {
+            ++attempts;
+            if (!reachable)
+            {
+                throw ConnectionException{"Unreachable"};
+            }
+            if (message == rejected)
+            {
+                throw InfluxDBException{"Intentional"};
+            }
+            if (failures > 0)
+            {
+                --failures;
+                throw RequestFailedException{"Unavailable", 503};
+            }
+
+            std::unique_lock lock{mutex};
+            blocked.wait(lock, [this]
+                         { return !blocking; });
+            messages.push_back(std::move(message));
+        }
+
+        std::string query(const std::string& query) override
+        {
+            ++queries;
+            if (!reachable)
+            {
+                throw ConnectionException{"Unreachable"};
+            }
+            if (query == rejected)
+            {
+                throw InfluxDBException{"Intentional"};
+            }
+            return "response of " + query;
+        }
+
+        void setTimePrecision(TimePrecision precision) override
+        {
+            std::lock_guard lock{mutex};
+            timePrecision = precision;
+        }
+
+        void setTimeout(std::chrono::milliseconds value) override
+        {
+            std::lock_guard lock{mutex};
+            timeout = value;
+        }
+
+        bool ping() override
+        {
+            ++pings;
+            return reachable;
+        }
+
+        std::vector<std::string> sent()
+        {
+            std::lock_guard lock{mutex};
+            return messages;
+        }
+
+        /// Lets blocked sends complete
+        void unblock()
+        {
+            {
+                std::lock_guard lock{mutex};
+                blocking = false;
+            }
+            blocked.notify_all();
+        }
+
+        std::atomic<bool> reachable{true};
+        /// Message or query rejected by the server
+        std::string rejected{};
+        /// Number of sends failing with a retryable status before the next succeeds
+        std::atomic<int> failures{0};
+        std::atomic<int> attempts{0};
+        std::atomic<int> queries{0};
+        std::atomic<int> pings{0};
+        /// Sends wait until unblock()
+        bool blocking{false};
+        std::mutex mutex{};
+        std::condition_variable blocked{};
+        std::vector<std::string> messages{};
+        TimePrecision timePrecision{TimePrecision::NanoSeconds};
+        std::chrono::milliseconds timeout{0};
+    };
+
+
+    /// Forwards to a RecordingTransport owned by the test
+    class TransportRef : public Transport
+    {
+    public:
+        explicit TransportRef(RecordingTransport& transport)
+            : transportImpl(transport)
+        {
+        }
+
+        void send(std::string&& message) override
+        {
+            transportImpl.send(std::move(message));
+        }
+
+        std::string query(const std::string& query) override
+        {
+            return transportImpl.query(query);
+        }
+
+        void setTimePrecision(TimePrecision precision) override
+        {
+            transportImpl.setTimePrecision(precision);
+        }
+
+        void setTimeout(std::chrono::milliseconds timeout) override
+        {
+            transportImpl.setTimeout(timeout);
+        }
+
+        bool ping() override
+        {
+            return transportImpl.ping();
+        }
+
+    private:
+        RecordingTransport& transportImpl;
+    };
+
+
+    template <class... Transports>
+    std::vector<std::unique_ptr<Transport>> transportsOf(Transports&... transports)
+    {
+        std::vector<std::unique_ptr<Transport>> refs;
+        (refs.push_back(std::make_unique<TransportRef>(transports)), ...);
+        return refs;
+    }
+
+    inline std::vector<std::unique_ptr<Transport>> transportsOf(std::vector<RecordingTransport>& transports)
+    {
+        std::vector<std::unique_ptr<Transport>> refs;
+        for (auto& transport : transports)
+        {
+            refs.push_back(std::make_unique<TransportRef>(transport));
+        }
+        return refs;
+    }
+
+}
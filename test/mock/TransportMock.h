@@ -32,9 +32,12 @@ namespace influxdb::test
     {
         MAKE_MOCK1(send, void(std::string&&), override);
         MAKE_MOCK1(query, std::string(const std::string&), override);
+        MAKE_MOCK3(queryChunked, void(const std::string&, std::size_t, const std::function<void(std::string_view)>&), override);
+        MAKE_MOCK1(queryArrow, std::string(const std::string&), override);
         MAKE_MOCK0(createDatabase, void(), override);
         MAKE_MOCK1(execute, std::string(const std::string&), override);
         MAKE_MOCK1(setTimePrecision, void(TimePrecision), override);
+        MAKE_MOCK1(setQueryEpoch, void(TimePrecision), override);
         MAKE_MOCK0(ping, bool(), override);
     };
 
@@ -57,6 +60,16 @@ namespace influxdb::test
             return mockImpl->query(query);
         }
 
+        void queryChunked(const std::string& query, std::size_t chunkSize, const std::function<void(std::string_view)>& onChunk) override
+        {
+            mockImpl->queryChunked(query, chunkSize, onChunk);
+        }
+
+        std::string queryArrow(const std::string& query) override
+        {
+            return mockImpl->queryArrow(query);
+        }
+
         std::string execute(const std::string& cmd) override
         {
             return mockImpl->execute(cmd);
@@ -72,6 +85,11 @@ namespace influxdb::test
             mockImpl->setTimePrecision(precision);
         }
 
+        void setQueryEpoch(TimePrecision epoch) override
+        {
+            mockImpl->setQueryEpoch(epoch);
+        }
+
         bool ping() override
         {
             return mockImpl->ping();